@@ -16,11 +16,11 @@ extension DataProvider: IDataProvider {
     public func getBalance(contractAddress: Address, address: Address) -> Single<BigUInt> {
         ethereumKit.call(contractAddress: contractAddress, data: BalanceOfMethod(owner: address).encodedABI())
                 .flatMap { data -> Single<BigUInt> in
-                    guard let value = BigUInt(data.prefix(32).hex, radix: 16) else {
+                    guard !data.isEmpty else {
                         return Single.error(Erc20Kit.TokenError.invalidHex)
                     }
 
-                    return Single.just(value)
+                    return Single.just(BigUInt(data.prefix(32)))
                 }
     }
 
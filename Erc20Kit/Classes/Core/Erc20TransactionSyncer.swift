@@ -6,16 +6,16 @@ class Erc20TransactionSyncer {
     private let provider: ITransactionProvider
     private let storage: Eip20Storage
 
+    private let queue = DispatchQueue(label: "io.horizontal-systems.erc20-kit.transaction-syncer", qos: .utility)
+    private var pendingEvents = [Event]()
+
     init(provider: ITransactionProvider, storage: Eip20Storage) {
         self.provider = provider
         self.storage = storage
     }
 
+    // the last stored event is the checkpoint of this syncer, so events are saved only after their transactions are stored
     private func handle(transactions: [ProviderTokenTransaction]) {
-        guard !transactions.isEmpty else {
-            return
-        }
-
         let events = transactions.map { tx in
             Event(
                     hash: tx.hash,
@@ -30,7 +30,9 @@ class Erc20TransactionSyncer {
             )
         }
 
-        storage.save(events: events)
+        queue.sync {
+            pendingEvents = events
+        }
     }
 
 }
@@ -41,6 +43,10 @@ extension Erc20TransactionSyncer: ITransactionSyncer {
         let lastBlockNumber = storage.lastEvent()?.blockNumber ?? 0
         let initial = lastBlockNumber == 0
 
+        queue.sync {
+            pendingEvents = []
+        }
+
         return provider.tokenTransactionsSingle(startBlock: lastBlockNumber + 1)
                 .do(onSuccess: { [weak self] transactions in
                     self?.handle(transactions: transactions)
@@ -66,3 +72,20 @@ extension Erc20TransactionSyncer: ITransactionSyncer {
     }
 
 }
+
+extension Erc20TransactionSyncer: ICheckpointedTransactionSyncer {
+
+    func saveCheckpoint() {
+        let events = queue.sync { () -> [Event] in
+            defer { pendingEvents = [] }
+            return pendingEvents
+        }
+
+        guard !events.isEmpty else {
+            return
+        }
+
+        storage.save(events: events)
+    }
+
+}
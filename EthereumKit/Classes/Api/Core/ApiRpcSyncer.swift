@@ -8,17 +8,21 @@ class ApiRpcSyncer {
     private let rpcApiProvider: IRpcApiProvider
     private let reachabilityManager: IReachabilityManager
     private let syncInterval: TimeInterval
+    private let reachabilityDisposeBag = DisposeBag()
     private var disposeBag = DisposeBag()
 
-    private var isStarted = false
     private var timer: Timer?
 
-    private(set) var state: SyncerState = .notReady(error: Kit.SyncError.notStarted) {
-        didSet {
-            if state != oldValue {
-                delegate?.didUpdate(state: state)
-            }
-        }
+    // state, start flag and last block height are written on stateQueue. Delegate calls are queued on delegateQueue
+    // while holding stateQueue, so that they are delivered in the same order as the writes
+    private let stateQueue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.api-rpc-syncer-state", qos: .utility)
+    private let delegateQueue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.api-rpc-syncer-delegate", qos: .utility)
+    private var isStarted = false
+    private var _state: SyncerState = .notReady(error: Kit.SyncError.notStarted)
+    private var lastBlockHeight: Int?
+
+    var state: SyncerState {
+        stateQueue.sync { _state }
     }
 
     init(rpcApiProvider: IRpcApiProvider, reachabilityManager: IReachabilityManager, syncInterval: TimeInterval) {
@@ -31,43 +35,86 @@ class ApiRpcSyncer {
                 .subscribe(onNext: { [weak self] reachable in
                     self?.handleUpdate(reachable: reachable)
                 })
-                .disposed(by: disposeBag)
+                .disposed(by: reachabilityDisposeBag)
     }
 
     deinit {
-        stop()
+        timer?.invalidate()
     }
 
     @objc func onFireTimer() {
-        rpcApiProvider.single(rpc: BlockNumberJsonRpc())
+        let disposable = rpcApiProvider.single(rpc: BlockNumberJsonRpc())
                 .subscribeOn(ConcurrentDispatchQueueScheduler(qos: .utility))
                 .subscribe(onSuccess: { [weak self] lastBlockHeight in
-                    self?.delegate?.didUpdate(lastBlockHeight: lastBlockHeight)
+                    self?.handle(lastBlockHeight: lastBlockHeight)
                 })
-                .disposed(by: disposeBag)
+
+        stateQueue.sync {
+            disposable.disposed(by: disposeBag)
+        }
+    }
+
+    // must be called on stateQueue
+    private func _set(state: SyncerState) {
+        guard _state != state else {
+            return
+        }
+
+        _state = state
+
+        delegateQueue.async { [weak self] in
+            self?.delegate?.didUpdate(state: state)
+        }
+    }
+
+    // responses of concurrent requests may arrive out of order, older block heights are dropped
+    private func handle(lastBlockHeight: Int) {
+        stateQueue.sync {
+            if let height = self.lastBlockHeight, height >= lastBlockHeight {
+                return
+            }
+
+            self.lastBlockHeight = lastBlockHeight
+
+            delegateQueue.async { [weak self] in
+                self?.delegate?.didUpdate(lastBlockHeight: lastBlockHeight)
+            }
+        }
     }
 
+    // timer is only accessed on the main queue
     private func startTimer() {
+        timer?.invalidate()
         timer = Timer.scheduledTimer(withTimeInterval: syncInterval, repeats: true) { [weak self] _ in
             self?.onFireTimer()
         }
         timer?.tolerance = 0.5
     }
 
+    private func stopTimer() {
+        timer?.invalidate()
+        timer = nil
+    }
+
     private func handleUpdate(reachable: Bool) {
-        guard isStarted else {
-            return
-        }
+        stateQueue.sync {
+            guard isStarted else {
+                return
+            }
 
-        if reachable {
-            state = .ready
+            if reachable {
+                _set(state: .ready)
 
-            DispatchQueue.main.async { [weak self] in
-                self?.startTimer()
+                DispatchQueue.main.async { [weak self] in
+                    self?.startTimer()
+                }
+            } else {
+                _set(state: .notReady(error: Kit.SyncError.noNetworkConnection))
+
+                DispatchQueue.main.async { [weak self] in
+                    self?.stopTimer()
+                }
             }
-        } else {
-            state = .notReady(error: Kit.SyncError.noNetworkConnection)
-            timer?.invalidate()
         }
     }
 
@@ -80,17 +127,23 @@ extension ApiRpcSyncer: IRpcSyncer {
     }
 
     func start() {
-        isStarted = true
+        stateQueue.sync {
+            isStarted = true
+        }
 
         handleUpdate(reachable: reachabilityManager.isReachable)
     }
 
     func stop() {
-        isStarted = false
+        stateQueue.sync {
+            isStarted = false
+            disposeBag = DisposeBag()
+            _set(state: .notReady(error: Kit.SyncError.notStarted))
 
-        disposeBag = DisposeBag()
-        state = .notReady(error: Kit.SyncError.notStarted)
-        timer?.invalidate()
+            DispatchQueue.main.async { [weak self] in
+                self?.stopTimer()
+            }
+        }
     }
 
     func single<T>(rpc: JsonRpc<T>) -> Single<T> {
@@ -9,11 +9,22 @@ class NodeApiProvider {
     private let urls: [URL]
 
     private let headers: HTTPHeaders
+    private let recording: RpcRecording?
+    private let metrics: RpcMetrics?
+    private let cache: RpcResponseCache?
+
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.node-api-provider", qos: .utility)
     private var currentRpcId = 0
+    private var currentUrlIndex = 0
+
+    private let coalescer = RpcRequestCoalescer()
 
-    init(networkManager: NetworkManager, urls: [URL], auth: String?) {
+    init(networkManager: NetworkManager, urls: [URL], auth: String?, recording: RpcRecording? = nil, metrics: RpcMetrics? = nil, cache: RpcResponseCache? = nil) {
         self.networkManager = networkManager
         self.urls = urls
+        self.recording = recording
+        self.metrics = metrics
+        self.cache = cache
 
         var headers = HTTPHeaders()
 
@@ -24,8 +35,82 @@ class NodeApiProvider {
         self.headers = headers
     }
 
-    private func rpcResultSingle(urlIndex: Int = 0, parameters: [String: Any]) -> Single<Any> {
-        networkManager.single(
+    private var nextRpcId: Int {
+        queue.sync {
+            currentRpcId += 1
+            return currentRpcId
+        }
+    }
+
+    private var preferredUrlIndex: Int {
+        get {
+            queue.sync { currentUrlIndex }
+        }
+        set {
+            queue.sync { currentUrlIndex = newValue }
+        }
+    }
+
+    var coalescedCount: Int {
+        coalescer.coalescedCount
+    }
+
+    // identical requests (same method and params) subscribed while one is in flight share its response
+    private func sharedResultSingle(parameters: [String: Any]) -> Single<Any> {
+        guard let key = RpcRequestKey.key(parameters: parameters) else {
+            return resultSingle(parameters: parameters)
+        }
+
+        return coalescer.single(
+                key: key,
+                onCoalesced: { [weak self] in
+                    self?.metrics?.recordCoalesced(method: parameters["method"] as? String ?? "unknown")
+                },
+                request: { [weak self] in
+                    guard let strongSelf = self else {
+                        return Single.error(Kit.KitError.weakReference)
+                    }
+
+                    return strongSelf.resultSingle(parameters: parameters)
+                }
+        )
+    }
+
+    private func resultSingle(parameters: [String: Any]) -> Single<Any> {
+        let requestBlockHeight = cache?.lastBlockHeight
+
+        return rpcResultSingle(urlIndex: preferredUrlIndex, attemptsLeft: urls.count, parameters: parameters)
+                .do(onSuccess: { [weak self] jsonObject in
+                    self?.recording?.record(parameters: parameters, response: jsonObject)
+                    self?.cache?.didReceive(response: jsonObject, parameters: parameters, requestBlockHeight: requestBlockHeight)
+                })
+    }
+
+    private func measured(single: Single<Any>, url: URL, parameters: [String: Any]) -> Single<Any> {
+        guard let metrics = metrics else {
+            return single
+        }
+
+        let method = parameters["method"] as? String ?? "unknown"
+        let node = url.host ?? url.absoluteString
+
+        return Single.deferred {
+            let startTime = CFAbsoluteTimeGetCurrent()
+
+            return single.do(
+                    onSuccess: { _ in
+                        metrics.record(method: method, node: node, duration: CFAbsoluteTimeGetCurrent() - startTime, failed: false)
+                    },
+                    onError: { _ in
+                        metrics.record(method: method, node: node, duration: CFAbsoluteTimeGetCurrent() - startTime, failed: true)
+                    }
+            )
+        }
+    }
+
+    // starts from the url that last responded successfully and tries each of the others once
+    private func rpcResultSingle(urlIndex: Int, attemptsLeft: Int, parameters: [String: Any]) -> Single<Any> {
+        let single: Single<Any> = networkManager.single(
                 url: urls[urlIndex],
                 method: .post,
                 parameters: parameters,
@@ -35,15 +120,18 @@ class NodeApiProvider {
                 interceptor: self,
                 responseCacherBehavior: .doNotCache
         )
+
+        return measured(single: single, url: urls[urlIndex], parameters: parameters)
+                .do(onSuccess: { [weak self] _ in
+                    self?.preferredUrlIndex = urlIndex
+                })
                 .catchError { [weak self] error in
                     guard let strongSelf = self else {
                         throw Kit.KitError.weakReference
                     }
 
-                    let nextIndex = urlIndex + 1
-
-                    if nextIndex < strongSelf.urls.count {
-                        return strongSelf.rpcResultSingle(urlIndex: nextIndex, parameters: parameters)
+                    if attemptsLeft > 1 {
+                        return strongSelf.rpcResultSingle(urlIndex: (urlIndex + 1) % strongSelf.urls.count, attemptsLeft: attemptsLeft - 1, parameters: parameters)
                     } else {
                         return Single.error(error)
                     }
@@ -99,20 +187,28 @@ extension NodeApiProvider: IRpcApiProvider {
     }
 
     func single<T>(rpc: JsonRpc<T>) -> Single<T> {
-        currentRpcId += 1
+        let parameters = rpc.parameters(id: nextRpcId)
 
-        return rpcResultSingle(parameters: rpc.parameters(id: currentRpcId))
-                .flatMap { jsonObject in
-                    do {
-                        guard let rpcResponse = JsonRpcResponse.response(jsonObject: jsonObject) else {
-                            throw RequestError.invalidResponse(jsonObject: jsonObject)
-                        }
+        if let response = cache?.response(parameters: parameters) {
+            return NodeApiProvider.parsed(jsonObject: response, rpc: rpc)
+        }
 
-                        return Single.just(try rpc.parse(response: rpcResponse))
-                    } catch {
-                        return Single.error(error)
-                    }
+        return sharedResultSingle(parameters: parameters)
+                .flatMap { jsonObject in
+                    NodeApiProvider.parsed(jsonObject: jsonObject, rpc: rpc)
                 }
     }
 
+    private static func parsed<T>(jsonObject: Any, rpc: JsonRpc<T>) -> Single<T> {
+        do {
+            guard let rpcResponse = JsonRpcResponse.response(jsonObject: jsonObject) else {
+                throw RequestError.invalidResponse(jsonObject: jsonObject)
+            }
+
+            return Single.just(try rpc.parse(response: rpcResponse))
+        } catch {
+            return Single.error(error)
+        }
+    }
+
 }
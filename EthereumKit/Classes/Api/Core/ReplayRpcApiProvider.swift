@@ -0,0 +1,53 @@
+import Foundation
+import RxSwift
+
+// Serves JSON-RPC requests from RpcRecording with simulated network latency, without any network access
+class ReplayRpcApiProvider {
+    private let recording: RpcRecording
+    private let latency: DispatchTimeInterval?
+    private let scheduler = ConcurrentDispatchQueueScheduler(qos: .utility)
+
+    init(recording: RpcRecording, latency: DispatchTimeInterval? = nil) {
+        self.recording = recording
+        self.latency = latency
+    }
+
+}
+
+extension ReplayRpcApiProvider: IRpcApiProvider {
+
+    var source: String {
+        "Replay"
+    }
+
+    func single<T>(rpc: JsonRpc<T>) -> Single<T> {
+        let single = Single<T>.from { [recording] in
+            let parameters = rpc.parameters()
+
+            guard let jsonObject = recording.response(parameters: parameters) else {
+                throw ReplayError.noRecordedResponse(parameters: parameters)
+            }
+
+            guard let rpcResponse = JsonRpcResponse.response(jsonObject: jsonObject) else {
+                throw NodeApiProvider.RequestError.invalidResponse(jsonObject: jsonObject)
+            }
+
+            return try rpc.parse(response: rpcResponse)
+        }
+
+        guard let latency = latency else {
+            return single
+        }
+
+        return single.delaySubscription(latency, scheduler: scheduler)
+    }
+
+}
+
+extension ReplayRpcApiProvider {
+
+    enum ReplayError: Error {
+        case noRecordedResponse(parameters: [String: Any])
+    }
+
+}
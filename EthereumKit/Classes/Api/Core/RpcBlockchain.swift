@@ -14,10 +14,28 @@ class RpcBlockchain {
     private let transactionBuilder: TransactionBuilder
     private var logger: Logger?
 
-    private(set) var syncState: SyncState = .notSynced(error: Kit.SyncError.notStarted) {
-        didSet {
-            if syncState != oldValue {
-                delegate?.onUpdate(syncState: syncState)
+    // Delegate calls are queued on delegateQueue while holding stateQueue, so that they are delivered in the same order
+    // as the writes. Block heights of responses arriving out of order are dropped
+    private let stateQueue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.rpc-blockchain-state", qos: .utility)
+    private let delegateQueue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.rpc-blockchain-delegate", qos: .utility)
+    private var _syncState: SyncState = .notSynced(error: Kit.SyncError.notStarted)
+    private var _lastBlockHeight: Int?
+
+    private(set) var syncState: SyncState {
+        get {
+            stateQueue.sync { _syncState }
+        }
+        set {
+            stateQueue.sync {
+                guard _syncState != newValue else {
+                    return
+                }
+
+                _syncState = newValue
+
+                delegateQueue.async { [weak self] in
+                    self?.delegate?.onUpdate(syncState: newValue)
+                }
             }
         }
     }
@@ -45,13 +63,28 @@ class RpcBlockchain {
     }
 
     private func onUpdate(lastBlockHeight: Int) {
-        storage.save(lastBlockHeight: lastBlockHeight)
-        delegate?.onUpdate(lastBlockHeight: lastBlockHeight)
+        stateQueue.sync {
+            if let height = _lastBlockHeight, height >= lastBlockHeight {
+                return
+            }
+
+            _lastBlockHeight = lastBlockHeight
+            storage.save(lastBlockHeight: lastBlockHeight)
+
+            delegateQueue.async { [weak self] in
+                self?.delegate?.onUpdate(lastBlockHeight: lastBlockHeight)
+            }
+        }
     }
 
     func onUpdate(accountState: AccountState) {
-        storage.save(accountState: accountState)
-        delegate?.onUpdate(accountState: accountState)
+        stateQueue.sync {
+            storage.save(accountState: accountState)
+
+            delegateQueue.async { [weak self] in
+                self?.delegate?.onUpdate(accountState: accountState)
+            }
+        }
     }
 
 }
@@ -0,0 +1,100 @@
+import Foundation
+
+// Collects latency histograms and failure counts of JSON-RPC requests per method and per node, and counts of coalesced requests per method
+class RpcMetrics {
+    private static let bucketBounds: [TimeInterval] = [0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10]
+
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.rpc-metrics", qos: .utility)
+    private var methodHistograms = [String: Histogram]()
+    private var nodeHistograms = [String: Histogram]()
+    private var coalescedCounts = [String: Int]()
+
+    // Each metric is written as its own family after its TYPE line, failures are counters next to the latency histograms
+    private func familyLines(histograms: [String: Histogram], labelName: String, histogramName: String, failedName: String) -> [String] {
+        let sortedHistograms = histograms.sorted(by: { $0.key < $1.key })
+        var lines = [String]()
+
+        lines.append("# TYPE \(histogramName) histogram")
+        for (value, histogram) in sortedHistograms {
+            lines.append(contentsOf: histogram.lines(name: histogramName, label: "\(labelName)=\"\(value)\""))
+        }
+
+        lines.append("# TYPE \(failedName) counter")
+        for (value, histogram) in sortedHistograms {
+            lines.append("\(failedName){\(labelName)=\"\(value)\"} \(histogram.failedCount)")
+        }
+
+        return lines
+    }
+
+    func record(method: String, node: String, duration: TimeInterval, failed: Bool) {
+        queue.async {
+            self.methodHistograms[method, default: Histogram()].add(duration: duration, failed: failed)
+            self.nodeHistograms[node, default: Histogram()].add(duration: duration, failed: failed)
+        }
+    }
+
+    func recordCoalesced(method: String) {
+        queue.async {
+            self.coalescedCounts[method, default: 0] += 1
+        }
+    }
+
+    // Prometheus text exposition format
+    var prometheusText: String {
+        queue.sync {
+            var lines = [String]()
+
+            lines.append(contentsOf: familyLines(histograms: methodHistograms, labelName: "method", histogramName: "ethereum_kit_rpc_duration_seconds", failedName: "ethereum_kit_rpc_failed_total"))
+            lines.append(contentsOf: familyLines(histograms: nodeHistograms, labelName: "node", histogramName: "ethereum_kit_rpc_node_duration_seconds", failedName: "ethereum_kit_rpc_node_failed_total"))
+
+            lines.append("# TYPE ethereum_kit_rpc_coalesced_total counter")
+            for (method, count) in coalescedCounts.sorted(by: { $0.key < $1.key }) {
+                lines.append("ethereum_kit_rpc_coalesced_total{method=\"\(method)\"} \(count)")
+            }
+
+            return lines.joined(separator: "\n") + "\n"
+        }
+    }
+
+}
+
+extension RpcMetrics {
+
+    struct Histogram {
+        private var bucketCounts = [Int](repeating: 0, count: RpcMetrics.bucketBounds.count)
+        private var count = 0
+        private(set) var failedCount = 0
+        private var sum: TimeInterval = 0
+
+        mutating func add(duration: TimeInterval, failed: Bool) {
+            if let index = RpcMetrics.bucketBounds.firstIndex(where: { duration <= $0 }) {
+                bucketCounts[index] += 1
+            }
+
+            count += 1
+            sum += duration
+
+            if failed {
+                failedCount += 1
+            }
+        }
+
+        func lines(name: String, label: String) -> [String] {
+            var lines = [String]()
+            var cumulativeCount = 0
+
+            for (index, bound) in RpcMetrics.bucketBounds.enumerated() {
+                cumulativeCount += bucketCounts[index]
+                lines.append("\(name)_bucket{\(label),le=\"\(bound)\"} \(cumulativeCount)")
+            }
+
+            lines.append("\(name)_bucket{\(label),le=\"+Inf\"} \(count)")
+            lines.append("\(name)_sum{\(label)} \(sum)")
+            lines.append("\(name)_count{\(label)} \(count)")
+
+            return lines
+        }
+    }
+
+}
@@ -0,0 +1,73 @@
+import Foundation
+
+// Keeps raw JSON-RPC responses keyed by request method and params, so that they can be saved to a file and replayed offline.
+// Passed to Kit.instance with a Mode to record responses of an HTTP RPC source or to serve requests from the recording
+public class RpcRecording {
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.rpc-recording", qos: .utility)
+    private var responses = [String: Any]()
+
+    public init() {
+    }
+
+    public init(fileUrl: URL) throws {
+        let data = try Data(contentsOf: fileUrl)
+
+        guard let entries = try JSONSerialization.jsonObject(with: data) as? [[String: Any]] else {
+            throw RecordingError.invalidFile
+        }
+
+        for entry in entries {
+            if let request = entry["request"] as? String, let response = entry["response"] {
+                responses[request] = response
+            }
+        }
+    }
+}
+
+extension RpcRecording {
+
+    func record(parameters: [String: Any], response: Any) {
+        guard let key = RpcRequestKey.key(parameters: parameters) else {
+            return
+        }
+
+        queue.sync {
+            responses[key] = response
+        }
+    }
+
+    func response(parameters: [String: Any]) -> Any? {
+        guard let key = RpcRequestKey.key(parameters: parameters) else {
+            return nil
+        }
+
+        return queue.sync {
+            responses[key]
+        }
+    }
+
+    public func save(fileUrl: URL) throws {
+        let entries = queue.sync {
+            responses.map { ["request": $0.key, "response": $0.value] }
+        }
+
+        let data = try JSONSerialization.data(withJSONObject: entries)
+        try data.write(to: fileUrl, options: .atomic)
+    }
+
+}
+
+extension RpcRecording {
+
+    public enum RecordingError: Error {
+        case invalidFile
+    }
+
+    public enum Mode {
+        // responses of the HTTP RPC source are added to the recording
+        case record(recording: RpcRecording)
+        // requests are served from the recording without network access, delayed by latency if given
+        case replay(recording: RpcRecording, latency: DispatchTimeInterval?)
+    }
+
+}
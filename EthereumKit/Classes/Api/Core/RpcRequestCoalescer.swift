@@ -0,0 +1,68 @@
+import Foundation
+import RxSwift
+
+// Identical requests subscribed while one is in flight share its response. The lookup is deferred to subscription, so an
+// entry only exists while its request is running and is removed as soon as it completes, before the shared response is
+// delivered. A subscriber that joined right before completion still gets the replayed response
+class RpcRequestCoalescer {
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.rpc-request-coalescer", qos: .utility)
+    private var inFlightSingles = [String: InFlightSingle]()
+    private var _coalescedCount = 0
+
+    var coalescedCount: Int {
+        queue.sync { _coalescedCount }
+    }
+
+    var inFlightCount: Int {
+        queue.sync { inFlightSingles.count }
+    }
+
+    private func remove(key: String, id: UUID) {
+        queue.sync {
+            if inFlightSingles[key]?.id == id {
+                inFlightSingles[key] = nil
+            }
+        }
+    }
+
+    // `onCoalesced` is called for each subscription that joins a request already in flight
+    func single(key: String, onCoalesced: @escaping () -> () = {}, request: @escaping () -> Single<Any>) -> Single<Any> {
+        Single.deferred { [weak self] in
+            guard let strongSelf = self else {
+                throw Kit.KitError.weakReference
+            }
+
+            return strongSelf.queue.sync {
+                if let inFlight = strongSelf.inFlightSingles[key] {
+                    strongSelf._coalescedCount += 1
+                    onCoalesced()
+                    return inFlight.single
+                }
+
+                let id = UUID()
+                let single = request()
+                        .do(
+                                onSuccess: { [weak self] _ in self?.remove(key: key, id: id) },
+                                onError: { [weak self] _ in self?.remove(key: key, id: id) },
+                                onDispose: { [weak self] in self?.remove(key: key, id: id) }
+                        )
+                        .asObservable()
+                        .share(replay: 1, scope: .forever)
+                        .asSingle()
+
+                strongSelf.inFlightSingles[key] = InFlightSingle(id: id, single: single)
+                return single
+            }
+        }
+    }
+
+}
+
+extension RpcRequestCoalescer {
+
+    private struct InFlightSingle {
+        let id: UUID
+        let single: Single<Any>
+    }
+
+}
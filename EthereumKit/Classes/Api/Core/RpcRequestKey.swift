@@ -0,0 +1,18 @@
+import Foundation
+
+// Identifies a JSON-RPC request by its method and params. The request id differs for each sent request, so it is left out
+// to match identical requests in flight, in the response cache and in recordings
+enum RpcRequestKey {
+
+    static func key(parameters: [String: Any]) -> String? {
+        var request = parameters
+        request["id"] = nil
+
+        guard let data = try? JSONSerialization.data(withJSONObject: request, options: .sortedKeys) else {
+            return nil
+        }
+
+        return String(data: data, encoding: .utf8)
+    }
+
+}
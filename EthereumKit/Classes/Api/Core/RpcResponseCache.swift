@@ -0,0 +1,194 @@
+import Foundation
+
+// Keeps JSON-RPC responses that can not change anymore, keyed by request method and params.
+// Responses pinned to a finalized block are kept until evicted by size, responses relative to the latest block
+// are dropped as soon as a new block height is seen in an eth_blockNumber response, or once they are older than `headTimeToLive`
+// when no new block height is seen (e.g. the syncer is stopped). Until the first block height is known only responses
+// that do not depend on it (e.g. blocks by hash) are kept
+class RpcResponseCache {
+    private static let blockParameterMethods: Set<String> = ["eth_call", "eth_getBalance", "eth_getTransactionCount", "eth_getCode", "eth_getStorageAt"]
+    private static let minedTransactionMethods: Set<String> = ["eth_getTransactionReceipt", "eth_getTransactionByHash"]
+
+    private let maxCount: Int
+    private let finalityDepth: Int
+    private let headTimeToLive: TimeInterval
+
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.rpc-response-cache", qos: .utility)
+    private var pinnedResponses = [String: Any]()
+    private var pinnedKeys = [String]()
+    private var headResponses = [String: HeadResponse]()
+    private var _lastBlockHeight: Int?
+
+    init(maxCount: Int = 1000, finalityDepth: Int = 12, headTimeToLive: TimeInterval = 15) {
+        self.maxCount = maxCount
+        self.finalityDepth = finalityDepth
+        self.headTimeToLive = headTimeToLive
+    }
+
+    private var uptime: TimeInterval {
+        ProcessInfo.processInfo.systemUptime
+    }
+
+    private func blockNumber(hex: Any?) -> Int? {
+        guard let hex = hex as? String, hex.hasPrefix("0x") else {
+            return nil
+        }
+
+        return Int(hex.stripHexPrefix(), radix: 16)
+    }
+
+    private func isFinalized(blockNumber: Int) -> Bool {
+        guard let lastBlockHeight = _lastBlockHeight else {
+            return false
+        }
+
+        return blockNumber + finalityDepth <= lastBlockHeight
+    }
+
+    private func scope(blockParameter: Any?) -> Scope? {
+        if let blockParameter = blockParameter as? String, blockParameter == DefaultBlockParameter.latest.raw {
+            return .head
+        }
+
+        guard let blockNumber = blockNumber(hex: blockParameter) else {
+            return nil
+        }
+
+        return isFinalized(blockNumber: blockNumber) ? .pinned : .head
+    }
+
+    private func scope(method: String, params: [Any], result: Any) -> Scope? {
+        if method == "eth_getBlockByHash" {
+            return .pinned
+        }
+
+        if method == "eth_getBlockByNumber" {
+            return scope(blockParameter: params.first)
+        }
+
+        if method == "eth_gasPrice" {
+            return .head
+        }
+
+        if RpcResponseCache.blockParameterMethods.contains(method) {
+            return scope(blockParameter: params.last)
+        }
+
+        // receipts and transactions are immutable only once their block is finalized
+        if RpcResponseCache.minedTransactionMethods.contains(method),
+           let blockNumber = blockNumber(hex: (result as? [String: Any])?["blockNumber"]), isFinalized(blockNumber: blockNumber) {
+            return .pinned
+        }
+
+        return nil
+    }
+
+    private func handleBlockNumber(response: [String: Any]) {
+        guard let blockHeight = blockNumber(hex: response["result"]) else {
+            return
+        }
+
+        if let lastBlockHeight = _lastBlockHeight, blockHeight <= lastBlockHeight {
+            return
+        }
+
+        _lastBlockHeight = blockHeight
+        headResponses = [:]
+    }
+
+    private func headResponse(key: String) -> Any? {
+        guard let headResponse = headResponses[key] else {
+            return nil
+        }
+
+        guard uptime - headResponse.storedAt < headTimeToLive else {
+            headResponses[key] = nil
+            return nil
+        }
+
+        return headResponse.response
+    }
+
+    private func store(pinned response: Any, key: String) {
+        if pinnedResponses.updateValue(response, forKey: key) == nil {
+            pinnedKeys.append(key)
+        }
+
+        // evict the oldest half at once to keep insertion amortized O(1)
+        if pinnedKeys.count > maxCount {
+            let evictedKeys = pinnedKeys.prefix(pinnedKeys.count - maxCount / 2)
+
+            for evictedKey in evictedKeys {
+                pinnedResponses[evictedKey] = nil
+            }
+
+            pinnedKeys.removeFirst(evictedKeys.count)
+        }
+    }
+
+}
+
+extension RpcResponseCache {
+
+    func response(parameters: [String: Any]) -> Any? {
+        guard let key = RpcRequestKey.key(parameters: parameters) else {
+            return nil
+        }
+
+        return queue.sync {
+            pinnedResponses[key] ?? headResponse(key: key)
+        }
+    }
+
+    var lastBlockHeight: Int? {
+        queue.sync { _lastBlockHeight }
+    }
+
+    // requestBlockHeight is the last block height known when the request was sent, responses relative to the latest block
+    // are not kept if a new block was seen since then
+    func didReceive(response: Any, parameters: [String: Any], requestBlockHeight: Int?) {
+        guard let method = parameters["method"] as? String, let response = response as? [String: Any] else {
+            return
+        }
+
+        if method == "eth_blockNumber" {
+            queue.sync {
+                handleBlockNumber(response: response)
+            }
+            return
+        }
+
+        // errors and empty results (e.g. receipt of a pending transaction) are never cached
+        guard response["error"] == nil, let result = response["result"], !(result is NSNull), let key = RpcRequestKey.key(parameters: parameters) else {
+            return
+        }
+
+        let params = parameters["params"] as? [Any] ?? []
+
+        queue.sync {
+            switch scope(method: method, params: params, result: result) {
+            case .pinned?: store(pinned: response, key: key)
+            case .head?:
+                if let requestBlockHeight = requestBlockHeight, requestBlockHeight == _lastBlockHeight, headResponses.count < maxCount {
+                    headResponses[key] = HeadResponse(response: response, storedAt: uptime)
+                }
+            case nil: ()
+            }
+        }
+    }
+
+}
+
+extension RpcResponseCache {
+
+    private enum Scope {
+        case pinned
+        case head
+    }
+
+    private struct HeadResponse {
+        let response: Any
+        let storedAt: TimeInterval
+    }
+
+}
@@ -5,9 +5,9 @@ class RpcWebSocket {
     weak var delegate: IRpcWebSocketDelegate?
 
     private let socket: IWebSocket
-    private var logger: Logger?
+    private let logger: AsyncLogger?
 
-    init(socket: IWebSocket, logger: Logger? = nil) {
+    init(socket: IWebSocket, logger: AsyncLogger? = nil) {
         self.socket = socket
         self.logger = logger
     }
@@ -184,8 +184,8 @@ extension WebSocketRpcSyncer: IRpcSyncer {
 
 extension WebSocketRpcSyncer {
 
-    static func instance(socket: IWebSocket, logger: Logger? = nil) -> WebSocketRpcSyncer {
-        let rpcSocket = RpcWebSocket(socket: socket, logger: logger)
+    static func instance(socket: IWebSocket, logger: Logger? = nil, minLogLevel: Logger.Level = .error) -> WebSocketRpcSyncer {
+        let rpcSocket = RpcWebSocket(socket: socket, logger: logger.map { AsyncLogger(logger: $0, minLogLevel: minLogLevel) })
         socket.delegate = rpcSocket
 
         let syncer = WebSocketRpcSyncer(rpcSocket: rpcSocket, logger: logger)
@@ -5,25 +5,57 @@ open class ContractMethodFactories {
 
     public init() {}
 
-    private var factories = [Data: IContractMethodFactory]()
+    // keyed by the 4-byte selector packed into an integer, so that lookups do not allocate
+    private var factories = [UInt32: IContractMethodFactory]()
+    // factories with method ids of another length, looked up by the input prefix as before
+    private var otherFactories = [Data: IContractMethodFactory]()
+
+    static func selector(input: Data) -> UInt32? {
+        guard input.count >= 4 else {
+            return nil
+        }
+
+        return input.prefix(4).reduce(UInt32(0)) { $0 << 8 | UInt32($1) }
+    }
+
+    private func register(methodId: Data, factory: IContractMethodFactory) {
+        if methodId.count == 4, let selector = ContractMethodFactories.selector(input: methodId) {
+            factories[selector] = factory
+        } else {
+            otherFactories[methodId] = factory
+        }
+    }
+
+    private func methodFactory(input: Data) -> IContractMethodFactory? {
+        if let selector = ContractMethodFactories.selector(input: input), let factory = factories[selector] {
+            return factory
+        }
+
+        guard !otherFactories.isEmpty else {
+            return nil
+        }
+
+        return otherFactories[Data(input.prefix(4))]
+    }
 
     public func register(factories: [IContractMethodFactory]) {
         for factory in factories {
             if let methodsFactory = factory as? IContractMethodsFactory {
                 for methodId in methodsFactory.methodIds {
-                    self.factories[methodId] = factory
+                    register(methodId: methodId, factory: factory)
                 }
             } else {
-                self.factories[factory.methodId] = factory
+                register(methodId: factory.methodId, factory: factory)
             }
         }
     }
 
     public func createMethod(input: Data) -> ContractMethod? {
-        let methodId = Data(input.prefix(4))
-        let erc20MethodFactory = factories[methodId]
+        guard let factory = methodFactory(input: input) else {
+            return nil
+        }
 
-        return try? erc20MethodFactory?.createMethod(inputArguments: Data(input.suffix(from: 4)))
+        return try? factory.createMethod(inputArguments: Data(input.dropFirst(4)))
     }
 
 }
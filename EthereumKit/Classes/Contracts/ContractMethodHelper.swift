@@ -3,6 +3,8 @@ import BigInt
 import Foundation
 
 public class ContractMethodHelper {
+    private static let methodIdsQueue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.contract-method-helper", qos: .utility)
+    private static var methodIds = [String: Data]()
 
     public struct StructParameter {
         let arguments: [Any]
@@ -12,72 +14,114 @@ public class ContractMethodHelper {
         }
     }
 
+    // Argument type of a dynamic array of structs, `arguments` are the types of the struct fields
+    public struct StructArrayParameter {
+        let arguments: [Any]
+
+        public init(_ arguments: [Any]) {
+            self.arguments = arguments
+        }
+    }
+
     public static func encodedABI(methodId: Data, arguments: [Any]) -> Data {
-        var data = methodId
+        var data = Data(capacity: methodId.count + arguments.count * 32)
         var arraysData = Data()
 
+        data.append(methodId)
+
         for argument in arguments {
             switch argument {
             case let argument as BigUInt:
-                data += pad(data: argument.serialize())
+                append(padded: argument.serialize(), to: &data)
+            case let argument as Bool:
+                append(padded: Data([argument ? 1 : 0]), to: &data)
             case let argument as String:
-                data += pad(data: Data(hex: argument) ?? Data())
+                append(padded: Data(hex: argument) ?? Data(), to: &data)
             case let argument as Address:
-                data += pad(data: argument.raw)
+                append(padded: argument.raw, to: &data)
             case let argument as [Address]:
-                data += pad(data: BigUInt(arguments.count * 32 + arraysData.count).serialize())
-                arraysData += encode(array: argument.map { $0.raw })
+                append(padded: BigUInt(arguments.count * 32 + arraysData.count).serialize(), to: &data)
+                encode(array: argument.map { $0.raw }, to: &arraysData)
             case let argument as Data:
-                data += pad(data: BigUInt(arguments.count * 32 + arraysData.count).serialize())
-                arraysData += pad(data: BigUInt(argument.count).serialize()) + argument
+                append(padded: BigUInt(arguments.count * 32 + arraysData.count).serialize(), to: &data)
+                append(padded: BigUInt(argument.count).serialize(), to: &arraysData)
+                arraysData.append(argument)
+                arraysData.append(contentsOf: repeatElement(UInt8(0), count: (32 - argument.count % 32) % 32))
+            case let argument as [StructParameter]:
+                append(padded: BigUInt(arguments.count * 32 + arraysData.count).serialize(), to: &data)
+                encode(structs: argument, to: &arraysData)
             default:
                 ()
             }
         }
 
-        return data + arraysData
+        data.append(arraysData)
+
+        return data
     }
 
+    // Returns an empty array for malformed input, `decode(inputArguments:argumentTypes:)` reports the error instead
     public class func decodeABI(inputArguments: Data, argumentTypes: [Any]) -> [Any] {
-        var position = 0
+        (try? decode(inputArguments: inputArguments, argumentTypes: argumentTypes)) ?? []
+    }
+
+    public class func decode(inputArguments: Data, argumentTypes: [Any]) throws -> [Any] {
+        try decode(inputArguments: inputArguments, base: 0, argumentTypes: argumentTypes)
+    }
+
+    // Offsets of dynamic arguments are relative to `base`, the start of the enclosing tuple, so that nested tuples
+    // are decoded in place instead of copying the rest of the input for each of them
+    private class func decode(inputArguments: Data, base: Int, argumentTypes: [Any]) throws -> [Any] {
+        var position = base
         var parsedArguments = [Any]()
 
         for type in argumentTypes {
             switch type {
             case is BigUInt.Type:
-                let data = Data(inputArguments[position..<position + 32])
+                let data = try word(at: position, inputArguments: inputArguments)
                 parsedArguments.append(BigUInt(data))
                 position += 32
 
             case is Address.Type:
-                let data = Data(inputArguments[position..<position + 32])
+                let data = try word(at: position, inputArguments: inputArguments)
                 parsedArguments.append(Address(raw: data))
                 position += 32
 
+            case is Bool.Type:
+                let data = try word(at: position, inputArguments: inputArguments)
+                parsedArguments.append(BigUInt(data) != 0)
+                position += 32
+
             case is [Address].Type:
-                let arrayPosition = parseInt(data: inputArguments[position..<position + 32])
-                let array: [Address] = parseAddresses(startPosition: arrayPosition, inputArguments: inputArguments)
+                let arrayPosition = try parseOffset(at: position, base: base, inputArguments: inputArguments)
+                let array: [Address] = try parseAddresses(startPosition: arrayPosition, inputArguments: inputArguments)
                 parsedArguments.append(array)
                 position += 32
 
             case is Data.Type:
-                let dataPosition = parseInt(data: inputArguments[position..<position + 32])
-                let data: Data = parseData(startPosition: dataPosition, inputArguments: inputArguments)
+                let dataPosition = try parseOffset(at: position, base: base, inputArguments: inputArguments)
+                let data: Data = try parseData(startPosition: dataPosition, inputArguments: inputArguments)
                 parsedArguments.append(data)
                 position += 32
 
             case is [Data].Type:
-                let dataPosition = parseInt(data: inputArguments[position..<position + 32])
-                let data: [Data] = parseDataArray(startPosition: dataPosition, inputArguments: inputArguments)
+                let dataPosition = try parseOffset(at: position, base: base, inputArguments: inputArguments)
+                let data: [Data] = try parseDataArray(startPosition: dataPosition, inputArguments: inputArguments)
                 parsedArguments.append(data)
                 position += 32
 
             case let object as StructParameter:
-                let argumentsPosition = parseInt(data: inputArguments[position..<position + 32])
-                let data: [Any] = decodeABI(inputArguments: Data(inputArguments[argumentsPosition..<inputArguments.count]), argumentTypes: object.arguments)
+                let argumentsPosition = try parseOffset(at: position, base: base, inputArguments: inputArguments)
+                let data: [Any] = try decode(inputArguments: inputArguments, base: argumentsPosition, argumentTypes: object.arguments)
                 parsedArguments.append(data)
                 position += 32
 
+            case let object as StructArrayParameter:
+                let arrayPosition = try parseOffset(at: position, base: base, inputArguments: inputArguments)
+                let structs: [[Any]] = try parseStructArray(startPosition: arrayPosition, inputArguments: inputArguments, argumentTypes: object.arguments)
+                parsedArguments.append(structs)
+                position += 32
+
             default: ()
             }
         }
@@ -86,56 +130,160 @@ public class ContractMethodHelper {
     }
 
     public static func methodId(signature: String) -> Data {
-        OpenSslKit.Kit.sha3(signature.data(using: .ascii)!)[0...3]
+        if let methodId = methodIdsQueue.sync(execute: { methodIds[signature] }) {
+            return methodId
+        }
+
+        let methodId = Data(OpenSslKit.Kit.sha3(signature.data(using: .ascii)!)[0...3])
+
+        methodIdsQueue.sync {
+            methodIds[signature] = methodId
+        }
+
+        return methodId
     }
 
-    private class func parseInt(data: Data) -> Int {
-        Data(data.reversed()).to(type: Int.self)
+    private class func word(at position: Int, inputArguments: Data) throws -> Data {
+        guard position >= 0, position <= inputArguments.count - 32 else {
+            throw DecodeError.outOfRange
+        }
+
+        let start = inputArguments.startIndex + position
+        return Data(inputArguments[start..<(start + 32)])
     }
 
-    private class func parseAddresses(startPosition: Int, inputArguments: Data) -> [Address] {
+    // Offsets and lengths must fit into Int, words with non-zero high bytes are rejected instead of being truncated
+    private class func parseInt(at position: Int, inputArguments: Data) throws -> Int {
+        let data = try word(at: position, inputArguments: inputArguments)
+
+        guard data.prefix(24).allSatisfy({ $0 == 0 }) else {
+            throw DecodeError.invalidInteger
+        }
+
+        let value = data.suffix(8).reduce(UInt64(0)) { $0 << 8 | UInt64($1) }
+
+        guard value <= UInt64(Int.max) else {
+            throw DecodeError.invalidInteger
+        }
+
+        return Int(value)
+    }
+
+    private class func parseOffset(at position: Int, base: Int, inputArguments: Data) throws -> Int {
+        let offset = try parseInt(at: position, inputArguments: inputArguments)
+
+        guard offset <= inputArguments.count - base else {
+            throw DecodeError.outOfRange
+        }
+
+        return base + offset
+    }
+
+    // Returns the declared number of 32-byte elements following the length word at `startPosition`
+    private class func parseSize(startPosition: Int, inputArguments: Data) throws -> Int {
+        let size = try parseInt(at: startPosition, inputArguments: inputArguments)
+
+        guard size <= (inputArguments.count - startPosition - 32) / 32 else {
+            throw DecodeError.outOfRange
+        }
+
+        return size
+    }
+
+    private class func parseAddresses(startPosition: Int, inputArguments: Data) throws -> [Address] {
         let arrayStartPosition = startPosition + 32
-        let size = parseInt(data: inputArguments[startPosition..<arrayStartPosition])
+        let size = try parseSize(startPosition: startPosition, inputArguments: inputArguments)
         var addresses = [Address]()
 
         for i in 0..<size {
-            let addressData = Data(inputArguments[(arrayStartPosition + 32 * i)..<(arrayStartPosition + 32 * (i + 1))])
-            addresses.append(Address(raw: addressData))
+            addresses.append(Address(raw: try word(at: arrayStartPosition + 32 * i, inputArguments: inputArguments)))
         }
 
         return addresses
     }
 
-    private class func parseData(startPosition: Int, inputArguments: Data) -> Data {
+    private class func parseData(startPosition: Int, inputArguments: Data) throws -> Data {
         let dataStartPosition = startPosition + 32
-        let size = parseInt(data: inputArguments[startPosition..<dataStartPosition])
-        return Data(inputArguments[dataStartPosition..<(dataStartPosition + size)])
+        let size = try parseInt(at: startPosition, inputArguments: inputArguments)
+
+        guard size <= inputArguments.count - dataStartPosition else {
+            throw DecodeError.outOfRange
+        }
+
+        let start = inputArguments.startIndex + dataStartPosition
+        return Data(inputArguments[start..<(start + size)])
     }
 
-    private class func parseDataArray(startPosition: Int, inputArguments: Data) -> [Data] {
+    private class func parseDataArray(startPosition: Int, inputArguments: Data) throws -> [Data] {
         let arrayStartPosition = startPosition + 32
-        let size = parseInt(data: inputArguments[startPosition..<arrayStartPosition])
+        let size = try parseSize(startPosition: startPosition, inputArguments: inputArguments)
         var dataArray = [Data]()
 
         for i in 0..<size {
-            dataArray.append(Data(inputArguments[(arrayStartPosition + 32 * i)..<(arrayStartPosition + 32 * (i + 1))]))
+            dataArray.append(try word(at: arrayStartPosition + 32 * i, inputArguments: inputArguments))
         }
 
         return dataArray
     }
 
-    private static func encode(array: [Data]) -> Data {
-        var data = pad(data: BigUInt(array.count).serialize())
+    // Element offsets are relative to the first offset word, each element is decoded in place
+    private class func parseStructArray(startPosition: Int, inputArguments: Data, argumentTypes: [Any]) throws -> [[Any]] {
+        let elementsStartPosition = startPosition + 32
+        let size = try parseSize(startPosition: startPosition, inputArguments: inputArguments)
+        var structs = [[Any]]()
+        structs.reserveCapacity(size)
+
+        for i in 0..<size {
+            let elementPosition = try parseOffset(at: elementsStartPosition + 32 * i, base: elementsStartPosition, inputArguments: inputArguments)
+            structs.append(try decode(inputArguments: inputArguments, base: elementPosition, argumentTypes: argumentTypes))
+        }
+
+        return structs
+    }
+
+    // Structs are encoded as dynamic tuples: element offsets first, then the elements
+    private static func encode(structs: [StructParameter], to data: inout Data) {
+        let encodedStructs = structs.map { encodedABI(methodId: Data(), arguments: $0.arguments) }
+        var offset = structs.count * 32
+
+        append(padded: BigUInt(structs.count).serialize(), to: &data)
+
+        for encodedStruct in encodedStructs {
+            append(padded: BigUInt(offset).serialize(), to: &data)
+            offset += encodedStruct.count
+        }
+
+        for encodedStruct in encodedStructs {
+            data.append(encodedStruct)
+        }
+    }
+
+    private static func encode(array: [Data], to data: inout Data) {
+        data.reserveCapacity(data.count + (array.count + 1) * 32)
+
+        append(padded: BigUInt(array.count).serialize(), to: &data)
 
         for item in array {
-            data += pad(data: item)
+            append(padded: item, to: &data)
         }
+    }
 
-        return data
+    // appends left-padded 32-byte word in place, without allocating intermediate padded copy
+    private static func append(padded item: Data, to data: inout Data) {
+        if item.count < 32 {
+            data.append(contentsOf: repeatElement(UInt8(0), count: 32 - item.count))
+        }
+
+        data.append(item)
     }
 
-    private static func pad(data: Data) -> Data {
-        Data(repeating: 0, count: (max(0, 32 - data.count))) + data
+}
+
+extension ContractMethodHelper {
+
+    public enum DecodeError: Error {
+        case outOfRange
+        case invalidInteger
     }
 
 }
@@ -20,11 +20,11 @@ extension Eip1155Provider {
 
         return rpcApiProvider.single(rpc: rpc)
                 .flatMap { data -> Single<BigUInt> in
-                    guard let value = BigUInt(data.prefix(32).hex, radix: 16) else {
+                    guard !data.isEmpty else {
                         return Single.error(BalanceError.invalidHex)
                     }
 
-                    return Single.just(value)
+                    return Single.just(BigUInt(data.prefix(32)))
                 }
     }
 
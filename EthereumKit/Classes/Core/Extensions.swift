@@ -77,6 +77,25 @@ extension Collection {
 
 }
 
+extension Array {
+
+    func concurrentMap<T>(_ transform: (Element) throws -> T) rethrows -> [T] {
+        var results = [T?](repeating: nil, count: count)
+
+        results.withUnsafeMutableBufferPointer { buffer in
+            DispatchQueue.concurrentPerform(iterations: buffer.count) { index in
+                buffer[index] = try? transform(self[index])
+            }
+        }
+
+        // a rethrowing function may only throw from its parameter, so failed elements are transformed again to throw their error
+        return try results.enumerated().map { index, result in
+            try result ?? transform(self[index])
+        }
+    }
+
+}
+
 extension PrimitiveSequence where Trait == SingleTrait {
 
     static func from(callable: @escaping () throws -> Element) -> Single<Element> {
@@ -17,12 +17,13 @@ public class Kit {
     private let syncStateSubject = PublishSubject<SyncState>()
     private let accountStateSubject = PublishSubject<AccountState>()
 
-    private let blockchain: IBlockchain
+    let blockchain: IBlockchain
     private let transactionManager: TransactionManager
     private let transactionSyncManager: TransactionSyncManager
     private let decorationManager: DecorationManager
     public let eip20Storage: Eip20Storage
     private let state: EthereumKitState
+    private let rpcMetrics: RpcMetrics?
 
     public let address: Address
 
@@ -36,7 +37,7 @@ public class Kit {
     init(blockchain: IBlockchain, transactionManager: TransactionManager, transactionSyncManager: TransactionSyncManager,
          state: EthereumKitState = EthereumKitState(), address: Address, chain: Chain, uniqueId: String,
          transactionProvider: ITransactionProvider, decorationManager: DecorationManager, eip20Storage: Eip20Storage,
-         logger: Logger) {
+         rpcMetrics: RpcMetrics? = nil, logger: Logger) {
         self.blockchain = blockchain
         self.transactionManager = transactionManager
         self.transactionSyncManager = transactionSyncManager
@@ -47,6 +48,7 @@ public class Kit {
         self.transactionProvider = transactionProvider
         self.decorationManager = decorationManager
         self.eip20Storage = eip20Storage
+        self.rpcMetrics = rpcMetrics
         self.logger = logger
 
         state.accountState = blockchain.accountState
@@ -241,6 +243,11 @@ extension Kit {
         transactionManager.etherTransferTransactionData(to: to, value: value)
     }
 
+    // latency histograms of RPC requests in Prometheus text format, nil if metrics collection is not enabled
+    public var rpcMetricsText: String? {
+        rpcMetrics?.prometheusText
+    }
+
     public func statusInfo() -> [(String, Any)] {
         [
             ("Last Block Height", "\(state.lastBlockHeight.map { "\($0)" } ?? "N/A")"),
@@ -293,7 +300,7 @@ extension Kit {
         }
     }
 
-    public static func instance(address: Address, chain: Chain, rpcSource: RpcSource, transactionSource: TransactionSource, walletId: String, minLogLevel: Logger.Level = .error) throws -> Kit {
+    public static func instance(address: Address, chain: Chain, rpcSource: RpcSource, transactionSource: TransactionSource, walletId: String, collectRpcMetrics: Bool = false, rpcRecordingMode: RpcRecording.Mode? = nil, minLogLevel: Logger.Level = .error) throws -> Kit {
         let logger = Logger(minLogLevel: minLogLevel)
         let uniqueId = "\(walletId)-\(chain.id)"
 
@@ -301,14 +308,24 @@ extension Kit {
 
         let syncer: IRpcSyncer
         let reachabilityManager = ReachabilityManager()
+        let rpcMetrics = collectRpcMetrics ? RpcMetrics() : nil
+
+        switch (rpcSource, rpcRecordingMode) {
+        case let (_, .replay(recording, latency)?):
+            let apiProvider = ReplayRpcApiProvider(recording: recording, latency: latency)
+            syncer = ApiRpcSyncer(rpcApiProvider: apiProvider, reachabilityManager: reachabilityManager, syncInterval: chain.syncInterval)
+        case let (.http(urls, auth), _):
+            var recording: RpcRecording?
+
+            if case let .record(rpcRecording)? = rpcRecordingMode {
+                recording = rpcRecording
+            }
 
-        switch rpcSource {
-        case let .http(urls, auth):
-            let apiProvider = NodeApiProvider(networkManager: networkManager, urls: urls, auth: auth)
+            let apiProvider = NodeApiProvider(networkManager: networkManager, urls: urls, auth: auth, recording: recording, metrics: rpcMetrics, cache: RpcResponseCache())
             syncer = ApiRpcSyncer(rpcApiProvider: apiProvider, reachabilityManager: reachabilityManager, syncInterval: chain.syncInterval)
-        case let .webSocket(url, auth):
+        case let (.webSocket(url, auth), _):
             let socket = WebSocket(url: url, reachabilityManager: reachabilityManager, auth: auth, logger: logger)
-            syncer = WebSocketRpcSyncer.instance(socket: socket, logger: logger)
+            syncer = WebSocketRpcSyncer.instance(socket: socket, logger: logger, minLogLevel: minLogLevel)
         }
 
         let transactionBuilder = TransactionBuilder(chain: chain, address: address)
@@ -324,17 +341,19 @@ extension Kit {
         let internalTransactionSyncer = InternalTransactionSyncer(provider: transactionProvider, storage: transactionStorage)
         let decorationManager = DecorationManager(userAddress: address, storage: transactionStorage)
         let transactionManager = TransactionManager(userAddress: address, storage: transactionStorage, decorationManager: decorationManager, blockchain: blockchain, transactionProvider: transactionProvider)
+        let pendingTransactionSyncer = PendingTransactionSyncer(blockchain: blockchain, storage: transactionStorage, syncerStateStorage: transactionSyncerStateStorage)
         let transactionSyncManager = TransactionSyncManager(transactionManager: transactionManager)
 
         transactionSyncManager.add(syncer: ethereumTransactionSyncer)
         transactionSyncManager.add(syncer: internalTransactionSyncer)
+        transactionSyncManager.add(syncer: pendingTransactionSyncer)
 
         let eip20Storage = Eip20Storage(databaseDirectoryUrl: try dataDirectoryUrl(), databaseFileName: "eip20-\(uniqueId)")
 
         let kit = Kit(
                 blockchain: blockchain, transactionManager: transactionManager, transactionSyncManager: transactionSyncManager,
                 address: address, chain: chain, uniqueId: uniqueId, transactionProvider: transactionProvider, decorationManager: decorationManager,
-                eip20Storage: eip20Storage, logger: logger
+                eip20Storage: eip20Storage, rpcMetrics: rpcMetrics, logger: logger
         )
 
         blockchain.delegate = kit
@@ -22,11 +22,11 @@ public extension L1FeeProvider {
 
         return evmKit.call(contractAddress: contractAddress, data: data)
             .flatMap { data -> Single<BigUInt> in
-                guard let value = BigUInt(data.prefix(32).hex, radix: 16) else {
+                guard !data.isEmpty else {
                     return Single.error(L1FeeError.invalidHex)
                 }
 
-                return Single.just(value)
+                return Single.just(BigUInt(data.prefix(32)))
             }
     }
 }
@@ -0,0 +1,199 @@
+import Foundation
+import BigInt
+import RxSwift
+
+public class MulticallProvider {
+    // Multicall3 is deployed at the same address on all supported chains
+    public static let defaultContractAddress = try! Address(hex: "0xca11bde05977b3631167028862be2a173976ca11")
+
+    private let maxCallsPerRequest = 500
+    private let maxConcurrentNonceRequests = 10
+
+    private let blockchain: IBlockchain
+    private let contractAddress: Address
+
+    init(blockchain: IBlockchain, contractAddress: Address) {
+        self.blockchain = blockchain
+        self.contractAddress = contractAddress
+    }
+
+    private func aggregateSingle(calls: [Call], defaultBlockParameter: DefaultBlockParameter) -> Single<[Data?]> {
+        let data = TryAggregateMethod(calls: calls).encodedABI()
+
+        return blockchain.call(contractAddress: contractAddress, data: data, defaultBlockParameter: defaultBlockParameter)
+                .flatMap { data -> Single<[Data?]> in
+                    do {
+                        return Single.just(try TryAggregateMethod.decode(data: data, count: calls.count))
+                    } catch {
+                        return Single.error(error)
+                    }
+                }
+    }
+
+    // pins `latest` to the last known block, so that results of several requests are consistent
+    private func pinned(defaultBlockParameter: DefaultBlockParameter) -> DefaultBlockParameter {
+        if case .latest = defaultBlockParameter, let lastBlockHeight = blockchain.lastBlockHeight {
+            return .blockNumber(value: lastBlockHeight)
+        }
+
+        return defaultBlockParameter
+    }
+
+    private func noncesSingle(addresses: [Address], defaultBlockParameter: DefaultBlockParameter) -> Single<[Int]> {
+        let singles = addresses.enumerated().map { index, address in
+            blockchain.rpcSingle(rpcRequest: GetTransactionCountJsonRpc(address: address, defaultBlockParameter: defaultBlockParameter))
+                    .map { (index, $0) }
+                    .asObservable()
+        }
+
+        return Observable.from(singles)
+                .merge(maxConcurrent: maxConcurrentNonceRequests)
+                .toArray()
+                .map { results in
+                    results.sorted { $0.0 < $1.0 }.map { $0.1 }
+                }
+    }
+
+}
+
+extension MulticallProvider {
+
+    // Returns return data of each call in the order of given calls, nil for failed calls
+    public func callsSingle(calls: [Call], defaultBlockParameter: DefaultBlockParameter = .latest) -> Single<[Data?]> {
+        guard !calls.isEmpty else {
+            return Single.just([])
+        }
+
+        let chunks = stride(from: 0, to: calls.count, by: maxCallsPerRequest).map { start in
+            Array(calls[start..<min(start + maxCallsPerRequest, calls.count)])
+        }
+
+        let blockParameter = chunks.count > 1 ? pinned(defaultBlockParameter: defaultBlockParameter) : defaultBlockParameter
+
+        return Single.zip(chunks.map { aggregateSingle(calls: $0, defaultBlockParameter: blockParameter) })
+                .map { results in
+                    results.flatMap { $0 }
+                }
+    }
+
+    // Returns ETH balances of given addresses, fetched with Multicall3 getEthBalance calls
+    public func balancesSingle(addresses: [Address], defaultBlockParameter: DefaultBlockParameter = .latest) -> Single<[BigUInt]> {
+        let calls = addresses.map { Call(contractAddress: contractAddress, data: GetEthBalanceMethod(address: $0).encodedABI()) }
+
+        return callsSingle(calls: calls, defaultBlockParameter: defaultBlockParameter)
+                .flatMap { results -> Single<[BigUInt]> in
+                    var balances = [BigUInt]()
+
+                    for result in results {
+                        guard let result = result, result.count == 32 else {
+                            return Single.error(MulticallError.invalidResponse)
+                        }
+
+                        balances.append(BigUInt(result))
+                    }
+
+                    return Single.just(balances)
+                }
+    }
+
+    // Returns balances and nonces of given addresses at the same block. Balances are fetched in Multicall3 requests,
+    // nonces are not accessible from contracts and are fetched with a limited number of concurrent eth_getTransactionCount requests.
+    // Each address is requested once, even if given several times
+    public func accountStatesSingle(addresses: [Address], defaultBlockParameter: DefaultBlockParameter = .latest) -> Single<[Address: AccountState]> {
+        var seenAddresses = Set<Address>()
+        let uniqueAddresses = addresses.filter { seenAddresses.insert($0).inserted }
+
+        guard !uniqueAddresses.isEmpty else {
+            return Single.just([:])
+        }
+
+        let blockParameter = pinned(defaultBlockParameter: defaultBlockParameter)
+
+        return Single.zip(
+                        balancesSingle(addresses: uniqueAddresses, defaultBlockParameter: blockParameter),
+                        noncesSingle(addresses: uniqueAddresses, defaultBlockParameter: blockParameter)
+                )
+                .map { balances, nonces in
+                    let states = zip(balances, nonces).map { AccountState(balance: $0, nonce: $1) }
+                    return Dictionary(uniqueKeysWithValues: zip(uniqueAddresses, states))
+                }
+    }
+
+}
+
+extension MulticallProvider {
+
+    public struct Call {
+        public let contractAddress: Address
+        public let data: Data
+
+        public init(contractAddress: Address, data: Data) {
+            self.contractAddress = contractAddress
+            self.data = data
+        }
+    }
+
+    // getEthBalance(address addr) returns (uint256 balance)
+    class GetEthBalanceMethod: ContractMethod {
+        private let address: Address
+
+        init(address: Address) {
+            self.address = address
+
+            super.init()
+        }
+
+        override var methodSignature: String { "getEthBalance(address)" }
+        override var arguments: [Any] { [address] }
+    }
+
+    // tryAggregate(bool requireSuccess, (address target, bytes callData)[] calls) returns ((bool success, bytes returnData)[])
+    class TryAggregateMethod: ContractMethod {
+        private let calls: [Call]
+
+        init(calls: [Call]) {
+            self.calls = calls
+
+            super.init()
+        }
+
+        override var methodSignature: String { "tryAggregate(bool,(address,bytes)[])" }
+        override var arguments: [Any] {
+            [false, calls.map { ContractMethodHelper.StructParameter([$0.contractAddress, $0.data]) }]
+        }
+
+        static func decode(data: Data, count: Int) throws -> [Data?] {
+            let argumentTypes: [Any] = [ContractMethodHelper.StructArrayParameter([Bool.self, Data.self])]
+
+            guard let decoded = try? ContractMethodHelper.decode(inputArguments: data, argumentTypes: argumentTypes),
+                  let results = decoded.first as? [[Any]], results.count == count else {
+                throw MulticallError.invalidResponse
+            }
+
+            return try results.map { result in
+                guard result.count == 2, let success = result[0] as? Bool, let returnData = result[1] as? Data else {
+                    throw MulticallError.invalidResponse
+                }
+
+                return success ? returnData : nil
+            }
+        }
+    }
+
+}
+
+extension MulticallProvider {
+
+    public enum MulticallError: Error {
+        case invalidResponse
+    }
+
+}
+
+extension MulticallProvider {
+
+    public static func instance(evmKit: Kit, contractAddress: Address = MulticallProvider.defaultContractAddress) -> MulticallProvider {
+        MulticallProvider(blockchain: evmKit.blockchain, contractAddress: contractAddress)
+    }
+
+}
@@ -36,15 +36,31 @@ public protocol ITransactionSyncer {
     func transactionsSingle() -> Single<([Transaction], Bool)>
 }
 
+public protocol ICheckpointedTransactionSyncer: ITransactionSyncer {
+    // Saves the progress of the last transactionsSingle result, called once its transactions are stored and before they are decorated
+    func saveCheckpoint()
+}
+
 protocol ITransactionManagerDelegate: AnyObject {
     func onUpdate(transactionsSyncState: SyncState)
     func onUpdate(transactionsWithInternal: [FullTransaction])
 }
 
 public protocol IMethodDecorator {
+    // Decorators returning true are called from several threads at once when large batches of transactions are decoded,
+    // others are always called serially
+    var isThreadSafe: Bool { get }
     func contractMethod(input: Data) -> ContractMethod?
 }
 
+extension IMethodDecorator {
+
+    public var isThreadSafe: Bool {
+        false
+    }
+
+}
+
 public protocol IEventDecorator {
     func contractEventInstancesMap(transactions: [Transaction]) -> [Data: [ContractEventInstance]]
     func contractEventInstances(logs: [TransactionLog]) -> [ContractEventInstance]
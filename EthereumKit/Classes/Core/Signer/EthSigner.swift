@@ -28,6 +28,10 @@ class EthSigner {
         try cryptoUtils.ellipticSign(prefixed(message: message) ?? message, privateKey: privateKey)
     }
 
+    public func sign(messages: [Data]) throws -> [Data] {
+        try messages.concurrentMap { try sign(message: $0) }
+    }
+
     public func parseTypedData(rawJson: Data) throws -> EIP712TypedData {
         let decoder = JSONDecoder()
         return try decoder.decode(EIP712TypedData.self, from: rawJson)
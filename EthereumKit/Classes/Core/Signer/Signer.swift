@@ -20,6 +20,10 @@ public class Signer {
         try transactionSigner.signature(rawTransaction: rawTransaction)
     }
 
+    public func signatures(rawTransactions: [RawTransaction]) throws -> [Signature] {
+        try transactionSigner.signatures(rawTransactions: rawTransactions)
+    }
+
     public func signedTransaction(address: Address, value: BigUInt, transactionInput: Data = Data(), gasPrice: GasPrice, gasLimit: Int, nonce: Int) throws -> Data {
         let rawTransaction = RawTransaction(gasPrice: gasPrice, gasLimit: gasLimit, to: address, value: value, data: transactionInput, nonce: nonce)
         let signature = try transactionSigner.signature(rawTransaction: rawTransaction)
@@ -30,6 +34,10 @@ public class Signer {
         try ethSigner.sign(message: message)
     }
 
+    public func signed(messages: [Data]) throws -> [Data] {
+        try ethSigner.sign(messages: messages)
+    }
+
     public func parseTypedData(rawJson: Data) throws -> EIP712TypedData {
         try ethSigner.parseTypedData(rawJson: rawJson)
     }
@@ -141,12 +141,15 @@ extension TransactionManager {
         storage.transaction(hash: hash).flatMap { decorationManager.decorate(transactions: [$0]).first }
     }
 
-    @discardableResult func handle(transactions: [Transaction], initial: Bool = false) -> [FullTransaction] {
+    // `onSave` is called once the transactions are stored, before they are decorated
+    @discardableResult func handle(transactions: [Transaction], initial: Bool = false, onSave: () -> Void = {}) -> [FullTransaction] {
         guard !transactions.isEmpty else {
+            onSave()
             return []
         }
 
         storage.save(transactions: transactions)
+        onSave()
 
         let failedTransactions = failPendingTransactions()
         let transactions = transactions + failedTransactions
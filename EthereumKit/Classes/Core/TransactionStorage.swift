@@ -89,6 +89,20 @@ class TransactionStorage {
             }
         }
 
+        // history queries filter by tags and page by (timestamp, transactionIndex, hash), without indexes each of them scans all rows
+        migrator.registerMigration("create indexes for history queries") { db in
+            try db.create(index: "transactionTag_transactionHash", on: TransactionTagRecord.databaseTableName, columns: [TransactionTagRecord.Columns.transactionHash.name])
+            try db.create(index: "transactionTag_contractAddress_type", on: TransactionTagRecord.databaseTableName, columns: [TransactionTagRecord.Columns.contractAddress.name, TransactionTagRecord.Columns.type.name])
+            // a single (protocol, type) index serves both protocol only and protocol with type tag lookups
+            try db.create(index: "transactionTag_protocol_type", on: TransactionTagRecord.databaseTableName, columns: [TransactionTagRecord.Columns.protocol.name, TransactionTagRecord.Columns.type.name])
+
+            try db.create(index: "transaction_timestamp_transactionIndex_hash", on: Transaction.databaseTableName, columns: [Transaction.Columns.timestamp.name, Transaction.Columns.transactionIndex.name, Transaction.Columns.hash.name])
+            try db.create(index: "transaction_blockNumber", on: Transaction.databaseTableName, columns: [Transaction.Columns.blockNumber.name])
+            try db.create(index: "transaction_from_nonce", on: Transaction.databaseTableName, columns: [Transaction.Columns.from.name, Transaction.Columns.nonce.name])
+
+            try db.create(index: "internalTransaction_blockNumber", on: InternalTransaction.databaseTableName, columns: [InternalTransaction.Columns.blockNumber.name])
+        }
+
         return migrator
     }
 
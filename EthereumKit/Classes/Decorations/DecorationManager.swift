@@ -2,17 +2,42 @@ import Foundation
 import BigInt
 
 class DecorationManager {
+    static let concurrentDecodingThreshold = 100
+
     private let userAddress: Address
     private let storage: TransactionStorage
-    private var methodDecorators = [IMethodDecorator]()
-    private var eventDecorators = [IEventDecorator]()
-    private var transactionDecorators = [ITransactionDecorator]()
+
+    private let lock = NSLock()
+    private var _methodDecorators = [IMethodDecorator]()
+    private var _eventDecorators = [IEventDecorator]()
+    private var _transactionDecorators = [ITransactionDecorator]()
 
     init(userAddress: Address, storage: TransactionStorage) {
         self.userAddress = userAddress
         self.storage = storage
     }
 
+    private var methodDecorators: [IMethodDecorator] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return _methodDecorators
+    }
+
+    private var eventDecorators: [IEventDecorator] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return _eventDecorators
+    }
+
+    private var transactionDecorators: [ITransactionDecorator] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return _transactionDecorators
+    }
+
     private func internalTransactionsMap(transactions: [Transaction]) -> [Data: [InternalTransaction]] {
         let internalTransactions: [InternalTransaction]
 
@@ -26,13 +51,13 @@ class DecorationManager {
         var map = [Data: [InternalTransaction]]()
 
         for internalTransaction in internalTransactions {
-            map[internalTransaction.hash] = (map[internalTransaction.hash] ?? []) + [internalTransaction]
+            map[internalTransaction.hash, default: []].append(internalTransaction)
         }
 
         return map
     }
 
-    private func contractMethod(input: Data?) -> ContractMethod? {
+    private func contractMethod(input: Data?, methodDecorators: [IMethodDecorator]) -> ContractMethod? {
         guard let input = input else {
             return nil
         }
@@ -50,6 +75,21 @@ class DecorationManager {
         return nil
     }
 
+    private func contractMethod(input: Data?) -> ContractMethod? {
+        contractMethod(input: input, methodDecorators: methodDecorators)
+    }
+
+    // Inputs of large batches are decoded concurrently, unless one of the method decorators is not thread-safe
+    private func contractMethods(inputs: [Data?]) -> [ContractMethod?] {
+        let methodDecorators = self.methodDecorators
+
+        guard inputs.count > DecorationManager.concurrentDecodingThreshold, methodDecorators.allSatisfy({ $0.isThreadSafe }) else {
+            return inputs.map { contractMethod(input: $0, methodDecorators: methodDecorators) }
+        }
+
+        return inputs.concurrentMap { contractMethod(input: $0, methodDecorators: methodDecorators) }
+    }
+
     private func decoration(from: Address?, to: Address?, value: BigUInt?, contractMethod: ContractMethod?, internalTransactions: [InternalTransaction] = [], eventInstances: [ContractEventInstance] = []) -> TransactionDecoration {
         for decorator in transactionDecorators {
             if let decoration = decorator.decoration(from: from, to: to, value: value, contractMethod: contractMethod, internalTransactions: internalTransactions, eventInstances: eventInstances) {
@@ -82,15 +122,24 @@ class DecorationManager {
 extension DecorationManager {
 
     func add(methodDecorator: IMethodDecorator) {
-        methodDecorators.append(methodDecorator)
+        lock.lock()
+        defer { lock.unlock() }
+
+        _methodDecorators.append(methodDecorator)
     }
 
     func add(eventDecorator: IEventDecorator) {
-        eventDecorators.append(eventDecorator)
+        lock.lock()
+        defer { lock.unlock() }
+
+        _eventDecorators.append(eventDecorator)
     }
 
     func add(transactionDecorator: ITransactionDecorator) {
-        transactionDecorators.append(transactionDecorator)
+        lock.lock()
+        defer { lock.unlock() }
+
+        _transactionDecorators.append(transactionDecorator)
     }
 
     func decorateTransaction(from: Address, transactionData: TransactionData) -> TransactionDecoration? {
@@ -113,16 +162,18 @@ extension DecorationManager {
 
         for decorator in eventDecorators {
             for (hash, eventInstances) in decorator.contractEventInstancesMap(transactions: transactions) {
-                eventInstancesMap[hash] = (eventInstancesMap[hash] ?? []) + eventInstances
+                eventInstancesMap[hash, default: []].append(contentsOf: eventInstances)
             }
         }
 
-        return transactions.map { transaction in
+        let contractMethods = contractMethods(inputs: transactions.map { $0.input })
+
+        return zip(transactions, contractMethods).map { transaction, contractMethod in
             let decoration = decoration(
                     from: transaction.from,
                     to: transaction.to,
                     value: transaction.value,
-                    contractMethod: contractMethod(input: transaction.input),
+                    contractMethod: contractMethod,
                     internalTransactions: internalTransactionsMap[transaction.hash] ?? [],
                     eventInstances: eventInstancesMap[transaction.hash] ?? []
             )
@@ -47,6 +47,12 @@ public class Eip20Storage {
             try Event.deleteAll(db)
         }
 
+        // events are looked up by transaction hashes and the last synced one by blockNumber
+        migrator.registerMigration("create indexes for Event") { db in
+            try db.create(index: "event_hash", on: Event.databaseTableName, columns: [Event.Columns.hash.name])
+            try db.create(index: "event_blockNumber", on: Event.databaseTableName, columns: [Event.Columns.blockNumber.name])
+        }
+
         return migrator
     }
 
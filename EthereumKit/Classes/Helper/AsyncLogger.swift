@@ -0,0 +1,85 @@
+import Foundation
+import HsToolKit
+
+// Formats and writes log records on a background queue, so that logging on hot paths does not block the caller.
+// Records below `minLogLevel` are skipped on the caller thread without building the message. When too many records
+// are pending, new verbose/debug/info ones are dropped and counted instead of blocking; warnings and errors are never dropped
+class AsyncLogger {
+    private let logger: Logger
+    private let minLogLevel: Logger.Level
+    private let maxPendingCount: Int
+
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.async-logger", qos: .background)
+    private let lock = NSLock()
+
+    private var pendingCount = 0
+    private var _droppedCount = 0
+
+    init(logger: Logger, minLogLevel: Logger.Level, maxPendingCount: Int = 1000) {
+        self.logger = logger
+        self.minLogLevel = minLogLevel
+        self.maxPendingCount = maxPendingCount
+    }
+
+    var droppedCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+
+        return _droppedCount
+    }
+
+    private func reserve(level: Logger.Level) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard pendingCount < maxPendingCount || level.rawValue >= Logger.Level.warning.rawValue else {
+            _droppedCount += 1
+            return false
+        }
+
+        pendingCount += 1
+        return true
+    }
+
+    private func release() {
+        lock.lock()
+        pendingCount -= 1
+        lock.unlock()
+    }
+
+    func isEnabled(level: Logger.Level) -> Bool {
+        level.rawValue >= minLogLevel.rawValue
+    }
+
+    func log(level: Logger.Level, message: @autoclosure () -> String, context: [String]? = nil) {
+        guard isEnabled(level: level), reserve(level: level) else {
+            return
+        }
+
+        // the message may capture mutable state of the caller, so it is built before leaving the caller thread
+        let message = message()
+
+        queue.async { [logger] in
+            logger.log(level: level, message: message, context: context)
+            self.release()
+        }
+    }
+
+    func verbose(_ message: @autoclosure () -> String) {
+        log(level: .verbose, message: message())
+    }
+
+    func debug(_ message: @autoclosure () -> String) {
+        log(level: .debug, message: message())
+    }
+
+    func error(_ message: @autoclosure () -> String) {
+        log(level: .error, message: message())
+    }
+
+    // Blocks until all pending records are written
+    func flush() {
+        queue.sync {}
+    }
+
+}
@@ -39,45 +39,50 @@ struct RLP {
     }
 
     static func decode(input: Data) throws -> RLPElement {
-        guard input.count > 0 else {
+        try decode(input: input, position: input.startIndex, end: input.endIndex)
+    }
+
+    // decodes element at position in place, nested elements are read from the same buffer without copying the remaining input
+    private static func decode(input: Data, position: Int, end: Int) throws -> RLPElement {
+        guard end > position else {
             throw DecodeError.emptyData
         }
 
-        guard let (offset, dataLen, type) = decode_length(input) else {
+        guard let (offset, dataLen, type) = decode_length(input, position: position, end: end) else {
             throw DecodeError.invalidElementLength
         }
 
+        let dataStart = position + offset
+        let dataEnd = dataStart + dataLen
         var output: RLPElement;
 
         if type == .string {
-            output = RLPElement(type: .string, length: dataLen, lengthOfLengthBytes: offset, dataValue: input.subdata(in: offset..<(offset + dataLen)), listValue: nil)
+            output = RLPElement(type: .string, length: dataLen, lengthOfLengthBytes: offset, dataValue: input.subdata(in: dataStart..<dataEnd), listValue: nil)
         } else {
             var value = [RLPElement]()
+            var listDataOffset = dataStart
 
-            let listData = input.subdata(in: offset..<(offset + dataLen))
-            var listDataOffset = 0
-
-            while listDataOffset < listData.count {
-                let element = try decode(input: Data(listData.suffix(from: listDataOffset)))
+            while listDataOffset < dataEnd {
+                let element = try decode(input: input, position: listDataOffset, end: dataEnd)
 
                 value.append(element)
                 listDataOffset += element.length + element.lengthOfLengthBytes
             }
 
-            output = RLPElement(type: .list, length: dataLen, lengthOfLengthBytes: offset, dataValue: input.subdata(in: 0..<(offset + dataLen)), listValue: value)
+            output = RLPElement(type: .list, length: dataLen, lengthOfLengthBytes: offset, dataValue: input.subdata(in: position..<dataEnd), listValue: value)
         }
 
         return output
     }
 
-    private static func decode_length(_ input: Data) -> (Int, Int, ElementType)? {
-        let length = input.count
+    private static func decode_length(_ input: Data, position: Int, end: Int) -> (Int, Int, ElementType)? {
+        let length = end - position
 
-        guard input.count > 0 else {
+        guard length > 0 else {
             return nil
         }
 
-        let prefix = Int(input[0])
+        let prefix = Int(input[position])
 
         if prefix <= 0x7f {
             return (0, 1, .string)
@@ -86,26 +91,22 @@ struct RLP {
             return (1, prefix - 0x80, .string)
 
         } else if prefix <= 0xbf && length > prefix - 0xb7,
-                  let len = to_integer(input.subdata(in: 1..<(1 + prefix - 0xb7))),
+                  let len = to_integer(input.subdata(in: (position + 1)..<(position + 1 + prefix - 0xb7))),
                   length > prefix - 0xb7 + len {
 
             let lenOfStrLen = prefix - 0xb7
-            if let strLen = to_integer(input.subdata(in: 1..<(1 + lenOfStrLen))) {
-                return (1 + lenOfStrLen, strLen, .string)
-            }
+            return (1 + lenOfStrLen, len, .string)
 
         } else if prefix <= 0xf7 && length > prefix - 0xc0 {
             let listLen = prefix - 0xc0
             return (1, listLen, .list)
 
         } else if prefix <= 0xff && length > prefix - 0xf7,
-                  let len = to_integer(input.subdata(in: 1..<(1 + prefix - 0xf7))),
+                  let len = to_integer(input.subdata(in: (position + 1)..<(position + 1 + prefix - 0xf7))),
                   length > prefix - 0xf7 + len {
 
             let lenOfListLen = prefix - 0xf7
-            if let listLen = to_integer(input.subdata(in: 1..<(1 + lenOfListLen))) {
-                return (1 + lenOfListLen, listLen, .list)
-            }
+            return (1 + lenOfListLen, len, .list)
 
         }
 
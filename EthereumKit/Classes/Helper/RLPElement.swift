@@ -27,10 +27,11 @@ class RLPElement {
             return 0
         }
 
-        guard let uInt = UInt(dataValue.hex, radix: 16) else {
+        guard dataValue.count <= MemoryLayout<UInt>.size else {
             throw RLP.DecodeError.invalidIntValue
         }
 
+        let uInt = dataValue.reduce(UInt(0)) { $0 << 8 | UInt($1) }
         return Int(bitPattern: uInt)
     }
 
@@ -43,11 +44,7 @@ class RLPElement {
             return 0
         }
 
-        guard let bigInt = BigUInt(dataValue.hex, radix: 16) else {
-            throw RLP.DecodeError.invalidBigIntValue
-        }
-
-        return bigInt
+        return BigUInt(dataValue)
     }
 
     func stringValue() throws -> String {
@@ -81,9 +81,9 @@ extension DiscoveryStorage: IDiscoveryStorage {
     }
 
 
-    func nonUsedNode() -> NodeRecord? {
+    func nonUsedNodes() -> [NodeRecord] {
         return try! dbPool.read { db in
-            return try NodeRecord.filter(NodeRecord.Columns.used == false).order(NodeRecord.Columns.timestamp.asc).fetchOne(db)
+            return try NodeRecord.filter(NodeRecord.Columns.used == false).fetchAll(db)
         }
     }
 
@@ -29,7 +29,7 @@ protocol IDiscoveryStorage {
     func save(nodes: [NodeRecord])
     func remove(node: Node)
 
-    func nonUsedNode() -> NodeRecord?
+    func nonUsedNodes() -> [NodeRecord]
     func contain(nodeId: Data) -> Bool
     func setNonEligible(node: NodeRecord)
     func setUsed(node: NodeRecord)
@@ -36,20 +36,21 @@ class PacketParser: IPacketParser {
             throw PacketParseError.tooSmall
         }
         let hash = data.prefix(PacketParser.macSize)
-        let forHash = data.subdata(in: PacketParser.macSize..<data.count)
-        let sig = data.subdata(in: PacketParser.macSize..<PacketParser.headSize)
-        let type = data[PacketParser.headSize]
+        let type = data[data.startIndex + PacketParser.headSize]
 
-        let shouldHash = OpenSslKit.Kit.sha3(forHash)
+        // hash is checked on a slice of the datagram, the signature is copied only for valid packets
+        let shouldHash = OpenSslKit.Kit.sha3(data.dropFirst(PacketParser.macSize))
 
         guard shouldHash == hash else {
             throw PacketParseError.wrongHash
         }
 
-        let packageData = data.subdata(in: (PacketParser.headSize + 1)..<data.count)
+        let sig = Data(data[(data.startIndex + PacketParser.macSize)..<(data.startIndex + PacketParser.headSize)])
+
         guard let parser = packageParsers[type] else {
             throw PacketParseError.wrongType
         }
+        let packageData = Data(data.dropFirst(PacketParser.headSize + 1))
         let package = try parser.parse(data: packageData)
         return Packet(hash: hash, signature: sig, type: type, package: package)
     }
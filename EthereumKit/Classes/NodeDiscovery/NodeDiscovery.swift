@@ -8,6 +8,8 @@ enum DiscoveryError: Error {
 class NodeDiscovery {
     static let alpha = 3
     static let timeoutInterval: TimeInterval = 10_000
+    // in milliseconds as `timeoutInterval`, a live node answers a ping within a round trip, so a node replacing it does not wait long
+    static let pingTimeoutInterval: TimeInterval = 1_000
     static let expirationInterval: TimeInterval = 20
     static let selfHost = "127.0.0.1"
     static let selfPort = 30303
@@ -22,15 +24,19 @@ class NodeDiscovery {
     private let packetParser: IPacketParser
 
     private let selfNode: Node
+    private let nodeTable: NodeTable
+    private var pingedOldestIds = Set<Data>()
+    private var queriedIds = Set<Data>()
 
-    private var nodes = [Node]()
-
-    let queue = DispatchQueue.global(qos: .userInteractive)
-
+    // lookups, client callbacks and table mutations are serialized, so that a lookup started from NodeManager and
+    // from a neighbors response can not both pick the same nodes or exceed `alpha` requests in flight
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.node-discovery", qos: .userInteractive)
+    private let queueKey = DispatchSpecificKey<Bool>()
 
     init(ecKey: ECKey, factory: IUdpFactory, discoveryStorage: IDiscoveryStorage, state: NodeDiscoveryState = NodeDiscoveryState(), nodeParser: INodeParser, packetParser: IPacketParser) {
         let selfNodeId = ecKey.publicKeyPoint.x + ecKey.publicKeyPoint.y
         selfNode = Node(id: selfNodeId, host: NodeDiscovery.selfHost, port: NodeDiscovery.selfPort, discoveryPort: NodeDiscovery.selfPort)
+        nodeTable = NodeTable(selfId: selfNodeId)
 
         self.factory = factory
         self.discoveryStorage = discoveryStorage
@@ -38,6 +44,17 @@ class NodeDiscovery {
 
         self.nodeParser = nodeParser
         self.packetParser = packetParser
+
+        queue.setSpecific(key: queueKey, value: true)
+    }
+
+    // client callbacks may be called synchronously from a lookup already running on the queue
+    private func serialized(_ block: () throws -> ()) rethrows {
+        if DispatchQueue.getSpecific(key: queueKey) != nil {
+            try block()
+        } else {
+            try queue.sync(execute: block)
+        }
     }
 
     private func findNeighbors(from node: Node) throws {
@@ -57,22 +74,92 @@ class NodeDiscovery {
         try client.send(findNodeData)
     }
 
+    // Kademlia replacement rule: a node that does not fit into a full bucket replaces the least recently seen node
+    // of the bucket only if that node does not answer a ping
+    private func checkLiveness(of oldest: Node) throws {
+        guard !pingedOldestIds.contains(oldest.id) else {
+            return
+        }
+
+        let client = try factory.client(node: oldest, timeoutInterval: NodeDiscovery.pingTimeoutInterval)
+        let pingData = try factory.pingData(from: selfNode, to: oldest, expiration: NodeDiscovery.expirationInterval)
+
+        // removed when the client stops, so the node is pinged again only after the previous ping is answered or timed out
+        pingedOldestIds.insert(oldest.id)
+
+        client.delegate = self
+        client.listen()
+
+        try client.send(pingData)
+    }
+
+    // Stored nodes, e.g. boot nodes, are moved into the table once it runs out of not queried nodes
+    private func seedTable() {
+        for record in discoveryStorage.nonUsedNodes() {
+            discoveryStorage.setUsed(node: record)
+            nodeTable.add(node: Node(id: record.id, host: record.host, port: record.port, discoveryPort: record.discoveryPort))
+        }
+    }
+
+    // Queries the closest not queried nodes of the table, keeping up to `alpha` FIND_NODE requests in flight
+    private func lookupNodes() throws {
+        let freeCount = NodeDiscovery.alpha - state.clients.count
+
+        guard freeCount > 0 else {
+            return
+        }
+
+        var nodes = nodeTable.closest(count: freeCount, excludingIds: queriedIds)
+
+        if nodes.count < freeCount {
+            seedTable()
+            nodes = nodeTable.closest(count: freeCount, excludingIds: queriedIds)
+        }
+
+        // if there no one not queried node we can't discovery new nodes.
+        guard !nodes.isEmpty else {
+            if !processing {
+                throw DiscoveryError.allNodesUsed
+            }
+            return
+        }
+
+        for node in nodes {
+            queriedIds.insert(node.id)
+            try findNeighbors(from: node)
+        }
+    }
+
+    private func handle(neighbors: [Node]) throws {
+        var newNodes = [Node]()
+
+        for node in neighbors {
+            switch nodeTable.add(node: node) {
+            case .added:
+                if !discoveryStorage.contain(nodeId: node.id) {
+                    newNodes.append(node)
+                }
+            case .exists: ()
+            case .bucketFull(let oldest):
+                try? checkLiveness(of: oldest)
+            }
+        }
+
+        guard !newNodes.isEmpty else {
+            return
+        }
+
+        nodeManager?.add(nodes: newNodes)
+        try? lookupNodes()
+    }
+
 }
 
 extension NodeDiscovery: INodeDiscovery {
 
     func lookup() throws {
-        // if there no one not used node we can't discovery new nodes.
-        var discovering = false
-        for _ in 0..<NodeDiscovery.alpha {
-            if let node = discoveryStorage.nonUsedNode() {
-                discovering = true
-                discoveryStorage.setUsed(node: node)
-
-                try findNeighbors(from: Node(id: node.id, host: node.host, port: node.port, discoveryPort: node.discoveryPort))
-            } else if !discovering {
-                throw DiscoveryError.allNodesUsed
-            }
+        try serialized {
+            try lookupNodes()
         }
     }
 
@@ -85,34 +172,52 @@ extension NodeDiscovery: INodeDiscovery {
 extension NodeDiscovery: IUdpClientDelegate {
 
     func didStop(_ client: IUdpClient, by error: Error) {
-        if client.noResponse {
-            discoveryStorage.remove(node: client.node)
+        serialized {
+            pingedOldestIds.remove(client.node.id)
+
+            if client.noResponse {
+                discoveryStorage.remove(node: client.node)
+                queriedIds.remove(client.node.id)
+
+                if let replacement = nodeTable.remove(id: client.node.id), !discoveryStorage.contain(nodeId: replacement.id) {
+                    nodeManager?.add(nodes: [replacement])
+                }
+            }
+
+            state.remove(client: client)
         }
-        state.remove(client: client)
     }
 
     func didReceive(_ client: IUdpClient, data: Data) throws {
         guard let packet = try? packetParser.parse(data: data) else {
             return
         }
-        switch packet.type {
-        case 1:
-            guard let pingPackage = packet.package as? PingPackage else {
-                throw PacketParseError.wrongType
-            }
-            // todo: merge with ping method
-
-            let pongData = try factory.pongData(to: pingPackage.from, hash: packet.hash, expiration: NodeDiscovery.expirationInterval)
-            try client.send(pongData)
 
-            let findNodeData = try factory.findNodeData(target: selfNode.id, expiration: NodeDiscovery.expirationInterval)
-            try client.send(findNodeData)
-        case 4:
-            guard let neighborsPackage = packet.package as? NeighborsPackage else {
-                throw PacketParseError.wrongType
+        try serialized {
+            // the node answered, so it stays in its bucket instead of being replaced
+            nodeTable.touch(id: client.node.id)
+            pingedOldestIds.remove(client.node.id)
+
+            switch packet.type {
+            case 1:
+                guard let pingPackage = packet.package as? PingPackage else {
+                    throw PacketParseError.wrongType
+                }
+                // todo: merge with ping method
+
+                let pongData = try factory.pongData(to: pingPackage.from, hash: packet.hash, expiration: NodeDiscovery.expirationInterval)
+                try client.send(pongData)
+
+                let findNodeData = try factory.findNodeData(target: selfNode.id, expiration: NodeDiscovery.expirationInterval)
+                try client.send(findNodeData)
+            case 4:
+                guard let neighborsPackage = packet.package as? NeighborsPackage else {
+                    throw PacketParseError.wrongType
+                }
+
+                try handle(neighbors: neighborsPackage.nodes)
+            default: ()
             }
-            nodeManager?.add(nodes: neighborsPackage.nodes)
-        default: ()
         }
     }
 
@@ -0,0 +1,148 @@
+import Foundation
+
+// Kademlia table of discovered nodes. Nodes are bucketed by the log2 XOR distance between keccak256 of their id
+// and of the self node id. A bucket keeps at most `bucketSize` nodes, least recently seen first, so that the table
+// stays spread over distances instead of filling up with nodes returned by the first few neighbors. Nodes that do not
+// fit into a full bucket are kept as replacements and take the place of a bucket node that stops responding.
+// The table is not thread-safe, NodeDiscovery accesses it only from its own queue
+class NodeTable {
+    static let bucketSize = 16
+    static let replacementsSize = 10
+    static let hashBits = 256
+
+    private let selfIdHash: Data
+    private let bucketSize: Int
+
+    private var buckets = [[Node]](repeating: [], count: NodeTable.hashBits + 1)
+    private var replacements = [[Node]](repeating: [], count: NodeTable.hashBits + 1)
+    private var idHashes = [Data: Data]()
+
+    init(selfId: Data, bucketSize: Int = NodeTable.bucketSize) {
+        selfIdHash = CryptoUtils.shared.sha3(selfId)
+        self.bucketSize = bucketSize
+    }
+
+    static func distance(_ lhs: Data, _ rhs: Data) -> Data {
+        Data(zip(lhs, rhs).map { $0 ^ $1 })
+    }
+
+    // Number of bits after the first common prefix of two hashes, 0 for equal hashes
+    static func logDistance(_ lhs: Data, _ rhs: Data) -> Int {
+        for (offset, (left, right)) in zip(lhs, rhs).enumerated() where left != right {
+            return (lhs.count - offset) * 8 - (left ^ right).leadingZeroBitCount
+        }
+
+        return 0
+    }
+
+    private func indexOfBucket(hash: Data) -> Int {
+        NodeTable.logDistance(hash, selfIdHash)
+    }
+
+}
+
+extension NodeTable {
+
+    var count: Int {
+        idHashes.count
+    }
+
+    // When the bucket of the node is full, the node is kept as a replacement and the least recently seen node
+    // of the bucket is returned, so that it can be checked for liveness
+    @discardableResult func add(node: Node) -> AddResult {
+        guard idHashes[node.id] == nil else {
+            return .exists
+        }
+
+        let hash = CryptoUtils.shared.sha3(node.id)
+        let bucketIndex = indexOfBucket(hash: hash)
+
+        guard bucketIndex > 0 else {
+            return .exists
+        }
+
+        replacements[bucketIndex].removeAll { $0.id == node.id }
+
+        if let oldest = buckets[bucketIndex].first, buckets[bucketIndex].count >= bucketSize {
+            replacements[bucketIndex].append(node)
+
+            if replacements[bucketIndex].count > NodeTable.replacementsSize {
+                replacements[bucketIndex].removeFirst()
+            }
+
+            return .bucketFull(oldest: oldest)
+        }
+
+        buckets[bucketIndex].append(node)
+        idHashes[node.id] = hash
+
+        return .added
+    }
+
+    // Marks node as the most recently seen one of its bucket
+    func touch(id: Data) {
+        guard let hash = idHashes[id] else {
+            return
+        }
+
+        let bucketIndex = indexOfBucket(hash: hash)
+
+        if let index = buckets[bucketIndex].firstIndex(where: { $0.id == id }) {
+            buckets[bucketIndex].append(buckets[bucketIndex].remove(at: index))
+        }
+    }
+
+    // Returns the most recent replacement that took the place of the removed node
+    @discardableResult func remove(id: Data) -> Node? {
+        guard let hash = idHashes.removeValue(forKey: id) else {
+            return nil
+        }
+
+        let bucketIndex = indexOfBucket(hash: hash)
+        buckets[bucketIndex].removeAll { $0.id == id }
+
+        guard let replacement = replacements[bucketIndex].popLast() else {
+            return nil
+        }
+
+        buckets[bucketIndex].append(replacement)
+        idHashes[replacement.id] = CryptoUtils.shared.sha3(replacement.id)
+
+        return replacement
+    }
+
+    // Returns up to `count` nodes of the buckets, closest to the self node first. Buckets are ordered by distance,
+    // so only the nodes of the last used bucket have to be sorted
+    func closest(count: Int, excludingIds: Set<Data> = []) -> [Node] {
+        var nodes = [Node]()
+
+        for bucket in buckets where nodes.count < count {
+            let candidates = bucket.compactMap { node -> (node: Node, distance: Data)? in
+                guard !excludingIds.contains(node.id), let hash = idHashes[node.id] else {
+                    return nil
+                }
+
+                return (node: node, distance: NodeTable.distance(hash, selfIdHash))
+            }
+
+            nodes.append(contentsOf: candidates
+                    .sorted { $0.distance.lexicographicallyPrecedes($1.distance) }
+                    .prefix(count - nodes.count)
+                    .map { $0.node }
+            )
+        }
+
+        return nodes
+    }
+
+}
+
+extension NodeTable {
+
+    enum AddResult {
+        case added
+        case exists
+        case bucketFull(oldest: Node)
+    }
+
+}
@@ -1,21 +1,38 @@
 import HsToolKit
 
 class BlockSyncer {
+    // code of GetBlockHeaders in the LES capability, used to look up its cost in the flow control parameters of the peer
+    private static let getBlockHeadersMessageCode = 0x02
+
     private let storage: ISpvStorage
     private let blockHelper: IBlockHelper
     private let validator: BlockValidator
     private let headersLimit: Int
+    private let windowSize: Int
     private let logger: Logger?
 
     weak var delegate: IBlockSyncerDelegate?
 
     private var syncing = false
 
-    init(storage: ISpvStorage, blockHelper: IBlockHelper, validator: BlockValidator, headersLimit: Int = 50, logger: Logger? = nil) {
+    // Header ranges are requested ahead of validation: up to `windowSize` ranges are in flight at once.
+    // Each range starts at the last header of the previous one, so ranges are validated against each other as they land in order
+    private var lastBlockHeader: BlockHeader?
+    private var bestBlockHeight = 0
+    private var nextRequestHeight = 0
+    private var requestedHeights = Set<Int>()
+    private var receivedBlockHeaders = [Int: [BlockHeader]]()
+
+    // Ranges beyond the first one are requested only while their cost fits into the buffer the peer keeps for us
+    private var flowControl: FlowControl?
+    private var inFlightCount = 0
+
+    init(storage: ISpvStorage, blockHelper: IBlockHelper, validator: BlockValidator, headersLimit: Int = 50, windowSize: Int = 4, logger: Logger? = nil) {
         self.storage = storage
         self.blockHelper = blockHelper
         self.validator = validator
         self.headersLimit = headersLimit
+        self.windowSize = windowSize
         self.logger = logger
     }
 
@@ -33,33 +50,108 @@ class BlockSyncer {
         }
 
         syncing = true
+        self.bestBlockHeight = bestBlockHeight
+
+        startPipeline(taskPerformer: taskPerformer, from: lastBlockHeader)
+    }
 
-        taskPerformer.add(task: BlockHeadersTask(blockHeader: lastBlockHeader, limit: headersLimit, reverse: false))
+    private func startPipeline(taskPerformer: ITaskPerformer, from blockHeader: BlockHeader) {
+        lastBlockHeader = blockHeader
+        nextRequestHeight = blockHeader.height
+        requestedHeights = []
+        receivedBlockHeaders = [:]
+
+        fillWindow(taskPerformer: taskPerformer)
     }
 
-    private func handle(taskPerformer: ITaskPerformer, blockHeaders: [BlockHeader], blockHeader: BlockHeader) throws {
-        try validator.validate(blockHeaders: blockHeaders, from: blockHeader)
+    private func stopPipeline() {
+        lastBlockHeader = nil
+        requestedHeights = []
+        receivedBlockHeaders = [:]
+    }
 
-        storage.save(blockHeaders: blockHeaders)
+    private var requestCost: Int? {
+        flowControl?.maxCost(messageCode: BlockSyncer.getBlockHeadersMessageCode, count: headersLimit)
+    }
+
+    private func canRequest() -> Bool {
+        guard let flowControl = flowControl, let requestCost = requestCost else {
+            return true
+        }
 
-        guard let lastBlockHeader = blockHeaders.last else {
+        return flowControl.canRequest(cost: requestCost)
+    }
+
+    private func request(taskPerformer: ITaskPerformer, height: Int, reverse: Bool) {
+        if let requestCost = requestCost {
+            flowControl?.didRequest(cost: requestCost)
+        }
+
+        inFlightCount += 1
+        taskPerformer.add(task: BlockHeadersTask(height: height, limit: headersLimit, reverse: reverse))
+    }
+
+    private func didReceiveResponse(bufferValue: Int) {
+        inFlightCount = max(inFlightCount - 1, 0)
+
+        if let requestCost = requestCost {
+            flowControl?.update(bufferValue: bufferValue, pendingCost: inFlightCount * requestCost)
+        }
+    }
+
+    private func fillWindow(taskPerformer: ITaskPerformer) {
+        // the first range is always requested, even if the best block height is already reached, to detect forks
+        while requestedHeights.count < windowSize && (requestedHeights.isEmpty || nextRequestHeight <= bestBlockHeight && canRequest()) {
+            requestedHeights.insert(nextRequestHeight)
+            request(taskPerformer: taskPerformer, height: nextRequestHeight, reverse: false)
+
+            nextRequestHeight += max(headersLimit - 1, 1)
+        }
+    }
+
+    private func finish(taskPerformer: ITaskPerformer, lastBlockHeader: BlockHeader) {
+        stopPipeline()
+        delegate?.onSuccess(taskPerformer: taskPerformer, lastBlockHeader: lastBlockHeader)
+        syncing = false
+    }
+
+    private func handle(taskPerformer: ITaskPerformer, blockHeaders: [BlockHeader], height: Int) throws {
+        guard requestedHeights.remove(height) != nil else {
+            // response to a range of a stopped or restarted pipeline
             return
         }
 
-        delegate?.onUpdate(lastBlockHeader: lastBlockHeader)
+        receivedBlockHeaders[height] = blockHeaders
 
-        if blockHeaders.count < headersLimit {
-            delegate?.onSuccess(taskPerformer: taskPerformer, lastBlockHeader: lastBlockHeader)
-            syncing = false
-        } else {
-            taskPerformer.add(task: BlockHeadersTask(blockHeader: lastBlockHeader, limit: headersLimit, reverse: false))
+        while let lastBlockHeader = lastBlockHeader, let blockHeaders = receivedBlockHeaders.removeValue(forKey: lastBlockHeader.height) {
+            // the chain of the peer ends before this range, e.g. the best block height it announced was reorganized away
+            guard let newLastBlockHeader = blockHeaders.last else {
+                finish(taskPerformer: taskPerformer, lastBlockHeader: lastBlockHeader)
+                return
+            }
+
+            try validator.validate(blockHeaders: blockHeaders, from: lastBlockHeader)
+
+            storage.save(blockHeaders: blockHeaders)
+
+            delegate?.onUpdate(lastBlockHeader: newLastBlockHeader)
+
+            if blockHeaders.count < headersLimit {
+                finish(taskPerformer: taskPerformer, lastBlockHeader: newLastBlockHeader)
+                return
+            }
+
+            self.lastBlockHeader = newLastBlockHeader
+            bestBlockHeight = max(bestBlockHeight, newLastBlockHeader.height)
         }
+
+        fillWindow(taskPerformer: taskPerformer)
     }
 
-    private func handleFork(taskPerformer: ITaskPerformer, blockHeaders: [BlockHeader], blockHeader: BlockHeader) throws {
+    private func handleFork(taskPerformer: ITaskPerformer, blockHeaders: [BlockHeader], height: Int) throws {
         logger?.debug("Received reversed block headers")
 
-        let storedBlockHeaders = storage.reversedLastBlockHeaders(from: blockHeader.height, limit: blockHeaders.count)
+        let storedBlockHeaders = storage.reversedLastBlockHeaders(from: height, limit: blockHeaders.count)
 
         guard let forkedBlock = storedBlockHeaders.first(where: { storedBlockHeader in
             blockHeaders.contains { $0.hashHex == storedBlockHeader.hashHex && $0.height == storedBlockHeader.height }
@@ -69,25 +161,31 @@ class BlockSyncer {
 
         logger?.debug("Found forked block header: \(forkedBlock.height)")
 
-        taskPerformer.add(task: BlockHeadersTask(blockHeader: forkedBlock, limit: headersLimit, reverse: false))
+        startPipeline(taskPerformer: taskPerformer, from: forkedBlock)
     }
 
 }
 
 extension BlockSyncer: IBlockHeadersTaskHandlerDelegate {
 
-    func didReceive(peer: IPeer, blockHeaders: [BlockHeader], blockHeader: BlockHeader, reverse: Bool) {
+    func didReceive(peer: IPeer, blockHeaders: [BlockHeader], height: Int, reverse: Bool, bufferValue: Int) {
+        didReceiveResponse(bufferValue: bufferValue)
+
         do {
             if reverse {
-                try handleFork(taskPerformer: peer, blockHeaders: blockHeaders, blockHeader: blockHeader)
+                try handleFork(taskPerformer: peer, blockHeaders: blockHeaders, height: height)
             } else {
-                try handle(taskPerformer: peer, blockHeaders: blockHeaders, blockHeader: blockHeader)
+                try handle(taskPerformer: peer, blockHeaders: blockHeaders, height: height)
             }
         } catch BlockValidator.ValidationError.forkDetected {
-            logger?.debug("Fork detected! Requesting reversed headers for block \(blockHeader.height)")
+            // the failed range is the one starting at the last validated header
+            let forkHeight = lastBlockHeader?.height ?? height
+            logger?.debug("Fork detected! Requesting reversed headers for block \(forkHeight)")
 
-            peer.add(task: BlockHeadersTask(blockHeader: blockHeader, limit: headersLimit, reverse: true))
+            stopPipeline()
+            request(taskPerformer: peer, height: forkHeight, reverse: true)
         } catch {
+            stopPipeline()
             delegate?.onFailure(error: error)
             syncing = false
         }
@@ -97,7 +195,10 @@ extension BlockSyncer: IBlockHeadersTaskHandlerDelegate {
 
 extension BlockSyncer: IHandshakeTaskHandlerDelegate {
 
-    func didCompleteHandshake(peer: IPeer, bestBlockHash: Data, bestBlockHeight: Int) {
+    func didCompleteHandshake(peer: IPeer, bestBlockHash: Data, bestBlockHeight: Int, flowControl: FlowControl) {
+        self.flowControl = flowControl
+        inFlightCount = 0
+
         onUpdate(taskPerformer: peer, bestBlockHash: bestBlockHash, bestBlockHeight: bestBlockHeight)
     }
 
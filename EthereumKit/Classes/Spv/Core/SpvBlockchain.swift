@@ -189,11 +189,11 @@ extension SpvBlockchain: ITransactionSenderDelegate {
 
 extension SpvBlockchain {
 
-    static func instance(storage: ISpvStorage, nodeManager: NodeManager, transactionBuilder: TransactionBuilder, network: INetwork, address: Address, nodeKey: ECKey, logger: Logger? = nil) -> SpvBlockchain {
+    static func instance(storage: ISpvStorage, nodeManager: NodeManager, transactionBuilder: TransactionBuilder, network: INetwork, address: Address, nodeKey: ECKey, logger: Logger? = nil, minLogLevel: Logger.Level = .error) -> SpvBlockchain {
         let validator = BlockValidator()
         let blockHelper = BlockHelper(storage: storage, network: network)
 
-        let peerProvider = PeerProvider(network: network, connectionKey: nodeKey, logger: logger)
+        let peerProvider = PeerProvider(network: network, connectionKey: nodeKey, logger: logger.map { AsyncLogger(logger: $0, minLogLevel: minLogLevel) })
 
         let peer = PeerGroup(peerProvider: peerProvider, logger: logger)
 //        let peer = peerProvider.peer()
@@ -23,7 +23,7 @@ class Connection: NSObject {
     private var handshake: EncryptionHandshake?
     private var frameCodec: FrameCodec?
     private let factory: IFactory
-    private let logger: Logger?
+    private let logger: AsyncLogger?
 
     private var runLoop: RunLoop?
     private var readStream: Unmanaged<CFReadStream>?
@@ -36,7 +36,7 @@ class Connection: NSObject {
     var connected: Bool = false
     var handshakeSent: Bool = false
 
-    init(connectionKey: ECKey, node: Node, factory: IFactory = Factory.shared, logger: Logger? = nil) {
+    init(connectionKey: ECKey, node: Node, factory: IFactory = Factory.shared, logger: AsyncLogger? = nil) {
         self.connectionKey = connectionKey
         self.nodeId = node.id
         self.host = node.host
@@ -109,14 +109,20 @@ class Connection: NSObject {
             return
         }
 
+        var offset = packets.startIndex
+
         do {
-            while let frame = try frameCodec.readFrame(from: packets) {
-                packets = Data(packets.dropFirst(frame.size))
+            while let frame = try frameCodec.readFrame(from: packets[offset...]) {
+                offset += frame.size
                 delegate?.didReceive(frame: frame)
             }
         } catch {
             disconnect(error: error)
+            return
         }
+
+        // drop all read frames at once instead of copying the rest of the buffer after each frame
+        packets.removeSubrange(packets.startIndex..<offset)
     }
 
     func initiateHandshake() {
@@ -146,8 +152,8 @@ class Connection: NSObject {
         }
     }
 
-    private func log(_ message: String, level: Logger.Level = .debug) {
-        logger?.log(level: level, message: message, context: [logName])
+    private func log(_ message: @autoclosure () -> String, level: Logger.Level = .debug) {
+        logger?.log(level: level, message: message(), context: [logName])
     }
 
 }
@@ -13,7 +13,10 @@ class FrameCodec {
         self.decryptor = decryptor
     }
 
+    // `data` may be a slice of a bigger buffer, so that the caller does not need to copy the unread bytes for each frame
     func readFrame(from data: Data) throws -> Frame? {
+        let start = data.startIndex
+
         guard previousDecryptedHeader != nil || data.count >= Frame.minSize else {
             return nil
         }
@@ -23,8 +26,8 @@ class FrameCodec {
         if let previousDecryptedHeader = previousDecryptedHeader {
             decryptedHeader = previousDecryptedHeader
         } else {
-            let header = data.subdata(in: 0..<16)
-            let headerMac = data.subdata(in: 16..<32)
+            let header = Data(data[start..<(start + 16)])
+            let headerMac = data[(start + 16)..<(start + 32)]
             let updatedMac = helper.updateMac(mac: secrets.ingressMac, macKey: secrets.mac, data: header)
 
             guard updatedMac == headerMac else {
@@ -60,8 +63,8 @@ class FrameCodec {
 
         previousDecryptedHeader = nil
 
-        let frameBodyData = data.subdata(in: 32..<(frameSize - 16))
-        let frameBodyMac = data.subdata(in: (frameSize - 16)..<frameSize)
+        let frameBodyData = data[(start + 32)..<(start + frameSize - 16)]
+        let frameBodyMac = data[(start + frameSize - 16)..<(start + frameSize)]
         secrets.ingressMac.update(with: frameBodyData)
 
         let decryptedFrame: Data = decryptor.process(frameBodyData)
@@ -95,18 +98,21 @@ class FrameCodec {
             headerDataElements.append(frame.allFramesTotalSize)
         }
 
-        var header = helper.toThreeBytes(int: frameSize)
+        var header = Data(capacity: 16)
+        header += helper.toThreeBytes(int: frameSize)
         header += RLP.encode(headerDataElements)
-        header += Data(repeating: 0, count: 16 - header.count)
+        header.append(contentsOf: repeatElement(0, count: 16 - header.count))
 
         let encryptedHeader = encryptor.process(header)
         let headerMac = helper.updateMac(mac: secrets.egressMac, macKey: secrets.mac, data: encryptedHeader)
 
         // Body
-        var frameData = packetType + frame.payload
-        if frameSize % 16 > 0 {
-            frameData += Data(repeating: 0, count: 16 - frameSize % 16)
-        }
+        let paddingSize = frameSize % 16 > 0 ? 16 - frameSize % 16 : 0
+
+        var frameData = Data(capacity: frameSize + paddingSize)
+        frameData += packetType
+        frameData += frame.payload
+        frameData.append(contentsOf: repeatElement(0, count: paddingSize))
 
         let encryptedFrameData = encryptor.process(frameData)
         secrets.egressMac.update(with: encryptedFrameData)
@@ -114,7 +120,13 @@ class FrameCodec {
         let egressMac = secrets.egressMac.digest()
         let frameMac = helper.updateMac(mac: secrets.egressMac, macKey: secrets.mac, data: egressMac)
 
-        return encryptedHeader + headerMac + encryptedFrameData + frameMac
+        var encodedFrame = Data(capacity: 32 + encryptedFrameData.count + 16)
+        encodedFrame += encryptedHeader
+        encodedFrame += headerMac
+        encodedFrame += encryptedFrameData
+        encodedFrame += frameMac
+
+        return encodedFrame
     }
 
 }
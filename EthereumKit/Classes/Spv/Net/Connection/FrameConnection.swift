@@ -49,7 +49,7 @@ extension FrameConnection: IConnectionDelegate {
 
 extension FrameConnection {
 
-    static func instance(connectionKey: ECKey, node: Node, logger: Logger? = nil) -> FrameConnection {
+    static func instance(connectionKey: ECKey, node: Node, logger: AsyncLogger? = nil) -> FrameConnection {
         let connection = Connection(connectionKey: connectionKey, node: node, logger: logger)
         let frameConnection = FrameConnection(connection: connection)
 
@@ -12,10 +12,10 @@ class DevP2PConnection {
     weak var delegate: IDevP2PConnectionDelegate?
 
     private let frameConnection: IFrameConnection
-    private let logger: Logger?
+    private let logger: AsyncLogger?
     private var packetTypesMap: [Int: IMessage.Type] = DevP2PConnection.devP2PPacketTypesMap
 
-    init(frameConnection: IFrameConnection, logger: Logger? = nil) {
+    init(frameConnection: IFrameConnection, logger: AsyncLogger? = nil) {
         self.frameConnection = frameConnection
         self.logger = logger
     }
@@ -39,8 +39,8 @@ class DevP2PConnection {
 
     }
 
-    private func log(_ message: String, level: Logger.Level = .debug) {
-        logger?.log(level: level, message: message, context: [logName])
+    private func log(_ message: @autoclosure () -> String, level: Logger.Level = .debug) {
+        logger?.log(level: level, message: message(), context: [logName])
     }
 
 }
@@ -117,7 +117,7 @@ extension DevP2PConnection {
 
 extension DevP2PConnection {
 
-    static func instance(connectionKey: ECKey, node: Node, logger: Logger? = nil) -> DevP2PConnection {
+    static func instance(connectionKey: ECKey, node: Node, logger: AsyncLogger? = nil) -> DevP2PConnection {
         let frameConnection = FrameConnection.instance(connectionKey: connectionKey, node: node, logger: logger)
         let devP2PConnection = DevP2PConnection(frameConnection: frameConnection, logger: logger)
 
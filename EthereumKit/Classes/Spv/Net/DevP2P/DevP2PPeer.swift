@@ -8,9 +8,9 @@ class DevP2PPeer {
     private let myCapabilities: [Capability]
     private let myNodeId: Data
     private let port: Int
-    private let logger: Logger?
+    private let logger: AsyncLogger?
 
-    init(devP2PConnection: IDevP2PConnection, capabilityHelper: ICapabilityHelper, myCapabilities: [Capability], myNodeId: Data, port: Int, logger: Logger? = nil) {
+    init(devP2PConnection: IDevP2PConnection, capabilityHelper: ICapabilityHelper, myCapabilities: [Capability], myNodeId: Data, port: Int, logger: AsyncLogger? = nil) {
         self.devP2PConnection = devP2PConnection
         self.capabilityHelper = capabilityHelper
         self.myCapabilities = myCapabilities
@@ -53,8 +53,8 @@ class DevP2PPeer {
         // no actions required
     }
 
-    private func log(_ message: String, level: Logger.Level = .debug) {
-        logger?.log(level: level, message: message, context: [logName])
+    private func log(_ message: @autoclosure () -> String, level: Logger.Level = .debug) {
+        logger?.log(level: level, message: message(), context: [logName])
     }
 
 }
@@ -104,7 +104,7 @@ extension DevP2PPeer: IDevP2PConnectionDelegate {
 
 extension DevP2PPeer {
 
-    static func instance(key: ECKey, node: Node, capabilities: [Capability], logger: Logger? = nil) -> DevP2PPeer {
+    static func instance(key: ECKey, node: Node, capabilities: [Capability], logger: AsyncLogger? = nil) -> DevP2PPeer {
         let nodeId = key.publicKeyPoint.x + key.publicKeyPoint.y
         let port = 30303
 
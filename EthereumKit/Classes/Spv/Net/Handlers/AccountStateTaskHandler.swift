@@ -12,48 +12,7 @@ class AccountStateTaskHandler {
     private var tasks = [Int: AccountStateTask]()
 
     private func parse(proofsMessage: ProofsMessage, task: AccountStateTask) throws -> AccountStateSpv {
-        guard var lastNode = proofsMessage.nodes.last else {
-            throw ProofError.noNodes
-        }
-
-        guard lastNode.nodeType == TrieNode.NodeType.LEAF, var path = lastNode.getPath(element: nil) else {
-            throw ProofError.stateNodeNotFound
-        }
-
-        let rlpState = try RLP.decode(input: lastNode.elements[1]).listValue()
-        guard rlpState.count == 4 else {
-            throw ProofError.wrongState
-        }
-
-        let nonce = try rlpState[0].intValue()
-        let balance = try rlpState[1].bigIntValue()
-        let storageRoot = rlpState[2].dataValue
-        let codeHash = rlpState[3].dataValue
-
-        var lastNodeKey = lastNode.hash
-
-        for i in stride(from: proofsMessage.nodes.count - 2, through: 0, by: -1) {
-            lastNode = proofsMessage.nodes[i]
-
-            guard let partialPath = lastNode.getPath(element: lastNodeKey) else {
-                throw ProofError.nodesNotInterconnected
-            }
-
-            path = partialPath + path
-            lastNodeKey = lastNode.hash
-        }
-
-        let addressHash = CryptoUtils.shared.sha3(task.address.raw)
-
-        guard addressHash.hex == path else {
-            throw ProofError.pathDoesNotMatchAddressHash
-        }
-
-        guard task.blockHeader.stateRoot == lastNodeKey else {
-            throw ProofError.rootHashDoesNotMatchStateRoot
-        }
-
-        return AccountStateSpv(address: task.address, nonce: nonce, balance: balance, storageHash: storageRoot, codeHash: codeHash)
+        try TrieNode.accountState(proofNodes: proofsMessage.nodes, address: task.address, stateRoot: task.blockHeader.stateRoot)
     }
 
 }
@@ -97,16 +56,3 @@ extension AccountStateTaskHandler: IMessageHandler {
     }
 
 }
-
-extension AccountStateTaskHandler {
-
-    enum ProofError: Error {
-        case noNodes
-        case stateNodeNotFound
-        case nodesNotInterconnected
-        case pathDoesNotMatchAddressHash
-        case rootHashDoesNotMatchStateRoot
-        case wrongState
-    }
-
-}
@@ -1,5 +1,5 @@
 protocol IBlockHeadersTaskHandlerDelegate: AnyObject {
-    func didReceive(peer: IPeer, blockHeaders: [BlockHeader], blockHeader: BlockHeader, reverse: Bool)
+    func didReceive(peer: IPeer, blockHeaders: [BlockHeader], height: Int, reverse: Bool, bufferValue: Int)
 }
 
 class BlockHeadersTaskHandler {
@@ -24,7 +24,7 @@ extension BlockHeadersTaskHandler: ITaskHandler {
 
         tasks[requestId] = task
 
-        let message = GetBlockHeadersMessage(requestId: requestId, blockHeight: task.blockHeader.height, maxHeaders: task.limit, reverse: task.reverse ? 1 : 0)
+        let message = GetBlockHeadersMessage(requestId: requestId, blockHeight: task.height, maxHeaders: task.limit, reverse: task.reverse ? 1 : 0)
 
         requester.send(message: message)
 
@@ -44,7 +44,7 @@ extension BlockHeadersTaskHandler: IMessageHandler {
             return false
         }
 
-        delegate?.didReceive(peer: peer, blockHeaders: message.headers, blockHeader: task.blockHeader, reverse: task.reverse)
+        delegate?.didReceive(peer: peer, blockHeaders: message.headers, height: task.height, reverse: task.reverse, bufferValue: message.bv)
 
         return true
     }
@@ -1,5 +1,5 @@
 protocol IHandshakeTaskHandlerDelegate: AnyObject {
-    func didCompleteHandshake(peer: IPeer, bestBlockHash: Data, bestBlockHeight: Int)
+    func didCompleteHandshake(peer: IPeer, bestBlockHash: Data, bestBlockHeight: Int, flowControl: FlowControl)
 }
 
 class HandshakeTaskHandler {
@@ -64,7 +64,9 @@ extension HandshakeTaskHandler: IMessageHandler {
             throw LESPeer.ValidationError.expiredBestBlockHeight
         }
 
-        delegate?.didCompleteHandshake(peer: peer, bestBlockHash: message.headHash, bestBlockHeight: message.headHeight)
+        let flowControl = FlowControl(bufferLimit: message.flowControlBL, rechargeRate: message.flowControlMRR, maxCosts: message.flowControlMRC)
+
+        delegate?.didCompleteHandshake(peer: peer, bestBlockHash: message.headHash, bestBlockHeight: message.headHeight, flowControl: flowControl)
 
         return true
     }
@@ -0,0 +1,63 @@
+import Foundation
+
+// Client side estimate of the buffer a LES server keeps for this client. The server announces the buffer limit, its recharge
+// rate per second and the maximum cost of each request type in its STATUS message, charges each request with its cost and
+// disconnects clients that send requests over the buffer. Each reply carries the buffer value after the answered request
+class FlowControl {
+    private let bufferLimit: Int
+    private let rechargeRate: Int
+    private let maxCosts: [Int: MaxCost]
+    private let currentTime: () -> TimeInterval
+
+    private var bufferValue: Double
+    private var updatedAt: TimeInterval
+
+    init(bufferLimit: Int, rechargeRate: Int, maxCosts: [MaxCost], currentTime: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) {
+        self.bufferLimit = bufferLimit
+        self.rechargeRate = rechargeRate
+        self.currentTime = currentTime
+
+        var costs = [Int: MaxCost]()
+        for maxCost in maxCosts {
+            costs[maxCost.messageCode] = maxCost
+        }
+        self.maxCosts = costs
+
+        bufferValue = Double(bufferLimit)
+        updatedAt = currentTime()
+    }
+
+    private func recharge() {
+        let now = currentTime()
+
+        bufferValue = min(Double(bufferLimit), bufferValue + Double(rechargeRate) * (now - updatedAt))
+        updatedAt = now
+    }
+
+}
+
+extension FlowControl {
+
+    // Returns nil when the server did not announce a cost for the message code
+    func maxCost(messageCode: Int, count: Int) -> Int? {
+        maxCosts[messageCode].map { $0.baseCost + $0.requestCost * count }
+    }
+
+    func canRequest(cost: Int) -> Bool {
+        recharge()
+        return Double(cost) <= bufferValue
+    }
+
+    func didRequest(cost: Int) {
+        recharge()
+        bufferValue -= Double(cost)
+    }
+
+    // `pendingCost` is the cost of requests still in flight. Some of them may have been charged before the reply was sent,
+    // so the estimate stays below the real buffer value
+    func update(bufferValue: Int, pendingCost: Int) {
+        self.bufferValue = Double(min(bufferValue, bufferLimit) - pendingCost)
+        updatedAt = currentTime()
+    }
+
+}
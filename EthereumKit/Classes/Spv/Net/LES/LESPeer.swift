@@ -4,20 +4,20 @@ class LESPeer {
     weak var delegate: IPeerDelegate?
 
     private let devP2PPeer: IDevP2PPeer
-    private let logger: Logger?
+    private let logger: AsyncLogger?
 
     private var taskHandlers = [ITaskHandler]()
     private var messageHandlers = [IMessageHandler]()
 
     private var bestBlock: (hash: Data, height: Int)?
 
-    init(devP2PPeer: IDevP2PPeer, logger: Logger? = nil) {
+    init(devP2PPeer: IDevP2PPeer, logger: AsyncLogger? = nil) {
         self.devP2PPeer = devP2PPeer
         self.logger = logger
     }
 
-    private func log(_ message: String, level: Logger.Level = .debug) {
-        logger?.log(level: level, message: message, context: [devP2PPeer.logName])
+    private func log(_ message: @autoclosure () -> String, level: Logger.Level = .debug) {
+        logger?.log(level: level, message: message(), context: [devP2PPeer.logName])
     }
 
 }
@@ -114,7 +114,7 @@ extension LESPeer {
         0x15: TransactionStatusMessage.self
     ])
 
-    static func instance(key: ECKey, node: Node, logger: Logger? = nil) -> LESPeer {
+    static func instance(key: ECKey, node: Node, logger: AsyncLogger? = nil) -> LESPeer {
         let devP2PPeer = DevP2PPeer.instance(key: key, node: node, capabilities: [capability], logger: logger)
         let peer = LESPeer(devP2PPeer: devP2PPeer, logger: logger)
 
@@ -3,6 +3,12 @@ class MaxCost {
     let baseCost: Int
     let requestCost: Int
 
+    init(messageCode: Int, baseCost: Int, requestCost: Int) {
+        self.messageCode = messageCode
+        self.baseCost = baseCost
+        self.requestCost = requestCost
+    }
+
     init(rlp: RLPElement) throws {
         let list = try rlp.listValue()
 
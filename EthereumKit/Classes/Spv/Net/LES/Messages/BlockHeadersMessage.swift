@@ -19,12 +19,8 @@ class BlockHeadersMessage: IInMessage {
         self.requestId = try rlpList[0].intValue()
         self.bv = try rlpList[1].intValue()
 
-        var headers = [BlockHeader]()
-        for rlpHeader in try rlpList[2].listValue() {
-            headers.append(try BlockHeader(rlp: rlpHeader))
-        }
-
-        self.headers = headers
+        // headers are independent of each other, so they are decoded and hashed in parallel
+        self.headers = try rlpList[2].listValue().concurrentMap { try BlockHeader(rlp: $0) }
     }
 
     func encoded() -> Data {
@@ -1,73 +1,75 @@
 import Foundation
 
 class TrieNode {
-    private static let alphabet: [String] = ["0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "a", "b", "c", "d", "e", "f"]
-
     let nodeType: NodeType
     let hash: Data
     var elements: [Data]
 
-    private let encodedPath: String
+    // path nibbles of extension and leaf nodes, decoded from the compact (hex-prefix) encoding
+    private let path: [UInt8]
 
     init(rlp: RLPElement) throws {
         let rlpElements = try rlp.listValue()
-        elements = [Data]()
-        for element in rlpElements {
-            elements.append(element.dataValue)
-        }
+        elements = rlpElements.map { $0.dataValue }
 
         hash = CryptoUtils.shared.sha3(rlp.dataValue)
 
         if rlpElements.count == 17 {
             nodeType = NodeType.BRANCH
-            encodedPath = ""
+            path = []
         } else {
             let first = elements[0]
-            let nibble: UInt8 = first[0] >> 4
-
-            switch nibble {
-            case 0:
-                nodeType = NodeType.EXTENSION
-                encodedPath = first.subdata(in: 1..<first.count).hex
+            let flag: UInt8 = first[first.startIndex] >> 4
 
-            case 1:
-                nodeType = NodeType.EXTENSION
-                encodedPath = TrieNode.secondCharacter(ofByteInHex: first[0]) + first.subdata(in: 1..<first.count).hex
+            switch flag {
+            case 0, 1: nodeType = NodeType.EXTENSION
+            case 2, 3: nodeType = NodeType.LEAF
+            default: nodeType = NodeType.NULL
+            }
 
-            case 2:
-                nodeType = NodeType.LEAF
-                encodedPath = first.subdata(in: 1..<first.count).hex
+            path = nodeType == NodeType.NULL ? [] : TrieNode.nibbles(compactPath: first, odd: flag & 1 == 1)
+        }
+    }
 
-            case 3:
-                nodeType = NodeType.LEAF
-                encodedPath = TrieNode.secondCharacter(ofByteInHex: first[0]) + first.subdata(in: 1..<first.count).hex
+    private static func nibbles(compactPath: Data, odd: Bool) -> [UInt8] {
+        var nibbles = [UInt8]()
+        nibbles.reserveCapacity(compactPath.count * 2)
 
-            default:
-                nodeType = NodeType.NULL
-                encodedPath = ""
+        if odd {
+            nibbles.append(compactPath[compactPath.startIndex] & 0x0f)
+        }
 
-            }
+        for byte in compactPath.dropFirst() {
+            nibbles.append(byte >> 4)
+            nibbles.append(byte & 0x0f)
         }
+
+        return nibbles
     }
 
-    private static func secondCharacter(ofByteInHex byte: UInt8) -> String {
-        let byteString = String(byte, radix: 16)
+    static func nibbles(key: Data) -> [UInt8] {
+        var nibbles = [UInt8]()
+        nibbles.reserveCapacity(key.count * 2)
 
-        let startIndex = byteString.index(byteString.startIndex, offsetBy: 1)
-        return String(byteString[startIndex...])
+        for byte in key {
+            nibbles.append(byte >> 4)
+            nibbles.append(byte & 0x0f)
+        }
+
+        return nibbles
     }
 
-    func getPath(element: Data?) -> String? {
+    func getPath(element: Data?) -> [UInt8]? {
         if (element == nil && nodeType == NodeType.LEAF) {
-            return encodedPath
+            return path
         }
 
         for (i, elementInNode) in elements.enumerated() {
             if elementInNode == element {
                 if (nodeType == NodeType.BRANCH) {
-                    return TrieNode.alphabet[i]
+                    return [UInt8(i)]
                 } else if (nodeType == NodeType.EXTENSION) {
-                    return encodedPath
+                    return path
                 }
             }
         }
@@ -75,6 +77,54 @@ class TrieNode {
         return nil
     }
 
+    // Verifies that the proof nodes link the state root to the leaf of the given account and returns its state
+    static func accountState(proofNodes nodes: [TrieNode], address: Address, stateRoot: Data) throws -> AccountStateSpv {
+        guard var lastNode = nodes.last else {
+            throw ProofError.noNodes
+        }
+
+        guard lastNode.nodeType == NodeType.LEAF, let leafPath = lastNode.getPath(element: nil) else {
+            throw ProofError.stateNodeNotFound
+        }
+
+        let rlpState = try RLP.decode(input: lastNode.elements[1]).listValue()
+        guard rlpState.count == 4 else {
+            throw ProofError.wrongState
+        }
+
+        let nonce = try rlpState[0].intValue()
+        let balance = try rlpState[1].bigIntValue()
+        let storageRoot = rlpState[2].dataValue
+        let codeHash = rlpState[3].dataValue
+
+        // partial paths are collected from the leaf up and joined once at the end
+        var partialPaths = [leafPath]
+        var lastNodeKey = lastNode.hash
+
+        for i in stride(from: nodes.count - 2, through: 0, by: -1) {
+            lastNode = nodes[i]
+
+            guard let partialPath = lastNode.getPath(element: lastNodeKey) else {
+                throw ProofError.nodesNotInterconnected
+            }
+
+            partialPaths.append(partialPath)
+            lastNodeKey = lastNode.hash
+        }
+
+        let path = Array(partialPaths.reversed().joined())
+
+        guard TrieNode.nibbles(key: CryptoUtils.shared.sha3(address.raw)) == path else {
+            throw ProofError.pathDoesNotMatchAddressHash
+        }
+
+        guard stateRoot == lastNodeKey else {
+            throw ProofError.rootHashDoesNotMatchStateRoot
+        }
+
+        return AccountStateSpv(address: address, nonce: nonce, balance: balance, storageHash: storageRoot, codeHash: codeHash)
+    }
+
 }
 
 extension TrieNode: CustomStringConvertible {
@@ -94,4 +144,13 @@ extension TrieNode {
         case LEAF
     }
 
+    enum ProofError: Error {
+        case noNodes
+        case stateNodeNotFound
+        case nodesNotInterconnected
+        case pathDoesNotMatchAddressHash
+        case rootHashDoesNotMatchStateRoot
+        case wrongState
+    }
+
 }
@@ -3,9 +3,9 @@ import HsToolKit
 class PeerProvider {
     private let network: INetwork
     private let connectionKey: ECKey
-    private let logger: Logger?
+    private let logger: AsyncLogger?
 
-    init(network: INetwork, connectionKey: ECKey, logger: Logger? = nil) {
+    init(network: INetwork, connectionKey: ECKey, logger: AsyncLogger? = nil) {
         self.network = network
         self.connectionKey = connectionKey
         self.logger = logger
@@ -1,12 +1,16 @@
 class BlockHeadersTask: ITask {
-    let blockHeader: BlockHeader
+    let height: Int
     let limit: Int
     let reverse: Bool
 
-    init(blockHeader: BlockHeader, limit: Int, reverse: Bool) {
-        self.blockHeader = blockHeader
+    init(height: Int, limit: Int, reverse: Bool) {
+        self.height = height
         self.limit = limit
         self.reverse = reverse
     }
 
+    convenience init(blockHeader: BlockHeader, limit: Int, reverse: Bool) {
+        self.init(height: blockHeader.height, limit: limit, reverse: reverse)
+    }
+
 }
@@ -7,6 +7,9 @@ class EthereumTransactionSyncer {
     private let provider: ITransactionProvider
     private let storage: TransactionSyncerStateStorage
 
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.ethereum-transaction-syncer", qos: .utility)
+    private var pendingSyncerState: TransactionSyncerState?
+
     init(provider: ITransactionProvider, storage: TransactionSyncerStateStorage) {
         self.provider = provider
         self.storage = storage
@@ -17,8 +20,10 @@ class EthereumTransactionSyncer {
             return
         }
 
-        let syncerState = TransactionSyncerState(syncerId: syncerId, lastBlockNumber: maxBlockNumber)
-        try? storage.save(syncerState: syncerState)
+        // saved only after the transactions are stored, otherwise they would be skipped if the app stops in between
+        queue.sync {
+            pendingSyncerState = TransactionSyncerState(syncerId: syncerId, lastBlockNumber: maxBlockNumber)
+        }
     }
 
 }
@@ -29,6 +34,10 @@ extension EthereumTransactionSyncer: ITransactionSyncer {
         let lastBlockNumber = (try? storage.syncerState(syncerId: syncerId))?.lastBlockNumber ?? 0
         let initial = lastBlockNumber == 0
 
+        queue.sync {
+            pendingSyncerState = nil
+        }
+
         return provider.transactionsSingle(startBlock: lastBlockNumber + 1)
                 .do(onSuccess: { [weak self] providerTransactions in
                     self?.handle(providerTransactions: providerTransactions)
@@ -69,3 +78,18 @@ extension EthereumTransactionSyncer: ITransactionSyncer {
     }
 
 }
+
+extension EthereumTransactionSyncer: ICheckpointedTransactionSyncer {
+
+    func saveCheckpoint() {
+        let syncerState = queue.sync { () -> TransactionSyncerState? in
+            defer { pendingSyncerState = nil }
+            return pendingSyncerState
+        }
+
+        if let syncerState = syncerState {
+            try? storage.save(syncerState: syncerState)
+        }
+    }
+
+}
@@ -5,16 +5,17 @@ class InternalTransactionSyncer {
     private let provider: ITransactionProvider
     private let storage: TransactionStorage
 
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.internal-transaction-syncer", qos: .utility)
+    private var pendingInternalTransactions = [InternalTransaction]()
+
     init(provider: ITransactionProvider, storage: TransactionStorage) {
         self.provider = provider
         self.storage = storage
     }
 
+    // the last stored internal transaction is the checkpoint of this syncer, so they are saved only after the transactions
+    // they belong to are stored, otherwise those would be skipped if the app stops in between
     private func handle(transactions: [ProviderInternalTransaction]) {
-        guard !transactions.isEmpty else {
-            return
-        }
-
         let internalTransactions = transactions.map { tx in
             InternalTransaction(
                     hash: tx.hash,
@@ -26,7 +27,9 @@ class InternalTransactionSyncer {
             )
         }
 
-        storage.save(internalTransactions: internalTransactions)
+        queue.sync {
+            pendingInternalTransactions = internalTransactions
+        }
     }
 
 }
@@ -37,6 +40,10 @@ extension InternalTransactionSyncer: ITransactionSyncer {
         let lastBlockNumber = storage.lastInternalTransaction()?.blockNumber ?? 0
         let initial = lastBlockNumber == 0
 
+        queue.sync {
+            pendingInternalTransactions = []
+        }
+
         return provider.internalTransactionsSingle(startBlock: lastBlockNumber + 1)
                 .do(onSuccess: { [weak self] transactions in
                     self?.handle(transactions: transactions)
@@ -57,3 +64,20 @@ extension InternalTransactionSyncer: ITransactionSyncer {
     }
 
 }
+
+extension InternalTransactionSyncer: ICheckpointedTransactionSyncer {
+
+    func saveCheckpoint() {
+        let internalTransactions = queue.sync { () -> [InternalTransaction] in
+            defer { pendingInternalTransactions = [] }
+            return pendingInternalTransactions
+        }
+
+        guard !internalTransactions.isEmpty else {
+            return
+        }
+
+        storage.save(internalTransactions: internalTransactions)
+    }
+
+}
@@ -0,0 +1,152 @@
+import RxSwift
+import BigInt
+
+// Resolves pending transactions once per new block: scans the transaction hashes of blocks mined since the last check
+// and fetches receipts only for pending transactions found in them
+class PendingTransactionSyncer {
+    private let syncerId = "pending-transaction-syncer"
+    private let maxBlocksToScan = 20
+    private let maxConcurrentReceiptRequests = 10
+
+    private let blockchain: IBlockchain
+    private let storage: TransactionStorage
+    private let syncerStateStorage: TransactionSyncerStateStorage
+
+    private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.pending-transaction-syncer", qos: .utility)
+    private var pendingSyncerState: TransactionSyncerState?
+
+    init(blockchain: IBlockchain, storage: TransactionStorage, syncerStateStorage: TransactionSyncerStateStorage) {
+        self.blockchain = blockchain
+        self.storage = storage
+        self.syncerStateStorage = syncerStateStorage
+    }
+
+    // saved only after the resolved transactions are stored, otherwise they would stay pending if the app stops in between
+    private func handle(lastCheckedBlockNumber: Int) {
+        queue.sync {
+            pendingSyncerState = TransactionSyncerState(syncerId: syncerId, lastBlockNumber: lastCheckedBlockNumber)
+        }
+    }
+
+    private func blocksSingle(from: Int, to: Int) -> Single<[RpcBlock]> {
+        guard from <= to else {
+            return Single.just([])
+        }
+
+        return Single.zip((from...to).map { blockchain.getBlock(blockNumber: $0) })
+    }
+
+    private func includedTransactionsSingle(pendingTransactions: [Transaction], blocks: [RpcBlock]) -> Single<[Transaction]> {
+        var blocksByHash = [Data: RpcBlock]()
+
+        for block in blocks {
+            for transactionHash in block.transactionHashes ?? [] {
+                blocksByHash[transactionHash] = block
+            }
+        }
+
+        let includedTransactions = pendingTransactions.filter { blocksByHash[$0.hash] != nil }
+
+        return receiptTransactionsSingle(transactions: includedTransactions, timestamp: { blocksByHash[$0.hash]?.timestamp ?? $0.timestamp })
+    }
+
+    // Receipts are requested with a limited number of concurrent requests, since there may be many pending transactions
+    // when the block scan falls back to them
+    private func receiptTransactionsSingle(transactions: [Transaction], timestamp: @escaping (Transaction) -> Int) -> Single<[Transaction]> {
+        guard !transactions.isEmpty else {
+            return Single.just([])
+        }
+
+        let observables = transactions.map { transaction -> Observable<Transaction?> in
+            blockchain.transactionReceiptSingle(transactionHash: transaction.hash)
+                    .map { receipt -> Transaction? in
+                        Transaction(
+                                hash: transaction.hash,
+                                timestamp: timestamp(transaction),
+                                isFailed: receipt.status.map { $0 == 0 } ?? false,
+                                blockNumber: receipt.blockNumber,
+                                transactionIndex: receipt.transactionIndex,
+                                from: transaction.from,
+                                to: transaction.to,
+                                value: transaction.value,
+                                input: transaction.input,
+                                nonce: transaction.nonce,
+                                gasPrice: transaction.gasPrice,
+                                maxFeePerGas: transaction.maxFeePerGas,
+                                maxPriorityFeePerGas: transaction.maxPriorityFeePerGas,
+                                gasLimit: transaction.gasLimit,
+                                gasUsed: receipt.gasUsed
+                        )
+                    }
+                    .catchErrorJustReturn(nil)
+                    .asObservable()
+        }
+
+        return Observable.from(observables)
+                .merge(maxConcurrent: maxConcurrentReceiptRequests)
+                .toArray()
+                .map { $0.compactMap { $0 } }
+    }
+
+}
+
+extension PendingTransactionSyncer: ITransactionSyncer {
+
+    // Pending transactions are never part of an initial sync, so results without transactions are reported as initial
+    // to not turn an initial sync of other syncers into an incremental one
+    func transactionsSingle() -> Single<([Transaction], Bool)> {
+        queue.sync {
+            pendingSyncerState = nil
+        }
+
+        guard let lastBlockHeight = blockchain.lastBlockHeight else {
+            return Single.just(([], true))
+        }
+
+        let pendingTransactions = storage.pendingTransactions()
+
+        guard !pendingTransactions.isEmpty else {
+            handle(lastCheckedBlockNumber: lastBlockHeight)
+            return Single.just(([], true))
+        }
+
+        let single: Single<[Transaction]>
+
+        if let lastCheckedBlockNumber = (try? syncerStateStorage.syncerState(syncerId: syncerId))?.lastBlockNumber, lastBlockHeight - lastCheckedBlockNumber <= maxBlocksToScan {
+            // last checked block is scanned again, since a transaction may be saved after its block has been checked
+            single = blocksSingle(from: lastCheckedBlockNumber, to: lastBlockHeight)
+                    .flatMap { [weak self] blocks in
+                        guard let strongSelf = self else {
+                            throw Kit.KitError.weakReference
+                        }
+
+                        return strongSelf.includedTransactionsSingle(pendingTransactions: pendingTransactions, blocks: blocks)
+                    }
+        } else {
+            single = receiptTransactionsSingle(transactions: pendingTransactions, timestamp: { $0.timestamp })
+        }
+
+        return single
+                .do(onSuccess: { [weak self] _ in
+                    self?.handle(lastCheckedBlockNumber: lastBlockHeight)
+                })
+                .map { ($0, $0.isEmpty) }
+                .catchErrorJustReturn(([], true))
+    }
+
+}
+
+extension PendingTransactionSyncer: ICheckpointedTransactionSyncer {
+
+    func saveCheckpoint() {
+        let syncerState = queue.sync { () -> TransactionSyncerState? in
+            defer { pendingSyncerState = nil }
+            return pendingSyncerState
+        }
+
+        if let syncerState = syncerState {
+            try? syncerStateStorage.save(syncerState: syncerState)
+        }
+    }
+
+}
@@ -8,6 +8,7 @@ class TransactionSyncManager {
     private var _syncers = [ITransactionSyncer]()
 
     private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.transaction-sync-manager", qos: .utility)
+    private let handleQueue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.transaction-sync-manager-handle", qos: .utility)
 
     private let stateSubject = PublishSubject<SyncState>()
     private var _state: SyncState = .notSynced(error: Kit.SyncError.notStarted) {
@@ -22,7 +23,7 @@ class TransactionSyncManager {
         self.transactionManager = transactionManager
     }
 
-    private func _handle(resultArray: [([Transaction], Bool)]) {
+    private func handle(syncers: [ITransactionSyncer], resultArray: [([Transaction], Bool)]) {
         let transactions = Array(resultArray.map { $0.0 }.joined())
         let initial = resultArray.map { $0.1 }.allSatisfy { $0 }
 
@@ -30,16 +31,21 @@ class TransactionSyncManager {
 
         for transaction in transactions {
             if let existingTransaction = dictionary[transaction.hash] {
-                dictionary[transaction.hash] = _merge(lhsTransaction: existingTransaction, rhsTransaction: transaction)
+                dictionary[transaction.hash] = merge(lhsTransaction: existingTransaction, rhsTransaction: transaction)
             } else {
                 dictionary[transaction.hash] = transaction
             }
         }
 
-        transactionManager.handle(transactions: Array(dictionary.values), initial: initial)
+        // Syncers may keep the rows decorators read, e.g. internal transactions or token events, until their checkpoint is saved
+        transactionManager.handle(transactions: Array(dictionary.values), initial: initial) {
+            for syncer in syncers {
+                (syncer as? ICheckpointedTransactionSyncer)?.saveCheckpoint()
+            }
+        }
     }
 
-    private func _merge(lhsTransaction lhs: Transaction, rhsTransaction rhs: Transaction) -> Transaction {
+    private func merge(lhsTransaction lhs: Transaction, rhsTransaction rhs: Transaction) -> Transaction {
         Transaction(
                 hash: lhs.hash,
                 timestamp: lhs.timestamp,
@@ -60,10 +66,15 @@ class TransactionSyncManager {
         )
     }
 
-    private func handleSuccess(resultArray: [([Transaction], Bool)]) {
-        queue.async {
-            self._handle(resultArray: resultArray)
-            self._state = .synced
+    // Transactions are decorated and stored off the state queue, so that reading the state does not wait for a large
+    // initial sync. Checkpoints are saved once the transactions are stored, so an interrupted sync is fetched again instead of skipped
+    private func handleSuccess(syncers: [ITransactionSyncer], resultArray: [([Transaction], Bool)]) {
+        handleQueue.async {
+            self.handle(syncers: syncers, resultArray: resultArray)
+
+            self.queue.async {
+                self._state = .synced
+            }
         }
     }
 
@@ -80,11 +91,13 @@ class TransactionSyncManager {
 
         _state = .syncing(progress: nil)
 
-        Single.zip(_syncers.map { $0.transactionsSingle() })
+        let syncers = _syncers
+
+        Single.zip(syncers.map { $0.transactionsSingle() })
                 .subscribeOn(ConcurrentDispatchQueueScheduler(qos: .utility))
                 .subscribe(
                         onSuccess: { [weak self] resultArray in
-                            self?.handleSuccess(resultArray: resultArray)
+                            self?.handleSuccess(syncers: syncers, resultArray: resultArray)
                         },
                         onError: { [weak self] error in
                             self?.handleError(error: error)
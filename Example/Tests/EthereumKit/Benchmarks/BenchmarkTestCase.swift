@@ -0,0 +1,26 @@
+import XCTest
+
+// Base class of benchmarks. They are skipped in regular test runs and only run with ETHEREUM_KIT_BENCHMARKS=1
+// set in the environment of the test scheme
+class BenchmarkTestCase: XCTestCase {
+    static let environmentKey = "ETHEREUM_KIT_BENCHMARKS"
+
+    override func setUpWithError() throws {
+        try super.setUpWithError()
+        try XCTSkipUnless(ProcessInfo.processInfo.environment[BenchmarkTestCase.environmentKey] == "1", "Set \(BenchmarkTestCase.environmentKey)=1 to run benchmarks")
+    }
+
+    // Measures wall clock time of `iterations` runs of block, divide by iterations to get time per operation
+    func benchmark(iterations: Int, block: () throws -> ()) {
+        measure(metrics: [XCTClockMetric()]) {
+            do {
+                for _ in 0..<iterations {
+                    try block()
+                }
+            } catch {
+                XCTFail("Benchmark failed: \(error)")
+            }
+        }
+    }
+
+}
@@ -0,0 +1,134 @@
+import XCTest
+import BigInt
+import OpenSslKit
+@testable import EthereumKit
+
+class EncodingBenchmarkTests: BenchmarkTestCase {
+    private let address = Address(raw: Data(repeating: 0xab, count: 20))
+
+    func testSha3_1kb() {
+        let data = Data(repeating: 0x5a, count: 1024)
+
+        benchmark(iterations: 10_000) {
+            _ = OpenSslKit.Kit.sha3(data)
+        }
+    }
+
+    private var rlpBlock: [Any] {
+        let transaction: [Any] = [1, BigUInt(20_000_000_000), 21_000, address.raw, BigUInt(10).power(18), Data(repeating: 7, count: 68)]
+        return Array(repeating: transaction, count: 100)
+    }
+
+    func testRlpEncode_100Transactions() {
+        let block = rlpBlock
+
+        benchmark(iterations: 100) {
+            _ = RLP.encode(block)
+        }
+    }
+
+    func testRlpDecode_100Transactions() {
+        let encoded = RLP.encode(rlpBlock)
+
+        benchmark(iterations: 100) {
+            _ = try RLP.decode(input: encoded).listValue()
+        }
+    }
+
+    private let swapMethodId = ContractMethodHelper.methodId(signature: "swapExactTokensForTokens(uint256,uint256,address[],address,uint256)")
+
+    private var swapArguments: [Any] {
+        [BigUInt(10).power(18), BigUInt(1), [address, address, address], address, BigUInt(1_700_000_000)]
+    }
+
+    func testAbiEncodeSwap() {
+        let arguments = swapArguments
+
+        benchmark(iterations: 10_000) {
+            _ = ContractMethodHelper.encodedABI(methodId: swapMethodId, arguments: arguments)
+        }
+    }
+
+    func testAbiDecodeSwap() {
+        let inputArguments = Data(ContractMethodHelper.encodedABI(methodId: swapMethodId, arguments: swapArguments).dropFirst(4))
+        let argumentTypes: [Any] = [BigUInt.self, BigUInt.self, [Address].self, Address.self, BigUInt.self]
+
+        benchmark(iterations: 10_000) {
+            _ = ContractMethodHelper.decodeABI(inputArguments: inputArguments, argumentTypes: argumentTypes)
+        }
+    }
+
+    func testUInt256DecodeViaHex() {
+        let hex = Data(repeating: 0x7f, count: 32).hex
+
+        benchmark(iterations: 100_000) {
+            _ = BigUInt(hex, radix: 16)
+        }
+    }
+
+    func testUInt256DecodeBytes() {
+        let word = Data(repeating: 0x7f, count: 32)
+
+        benchmark(iterations: 100_000) {
+            _ = BigUInt(word)
+        }
+    }
+
+    func testUInt256FeeMath() {
+        let gasLimit = BigUInt(21_000)
+        let maxFeePerGas = BigUInt(100_000_000_000)
+
+        benchmark(iterations: 100_000) {
+            _ = gasLimit * maxFeePerGas
+        }
+    }
+
+    // Uniswap V2 getAmountOut with 0.3% fee
+    func testUInt256SwapAmountMath() {
+        let word = Data(repeating: 0x7f, count: 32)
+        let reserveIn = BigUInt(word.prefix(16))
+        let reserveOut = BigUInt(word.suffix(14))
+        let amountIn = BigUInt(1_000_000_000_000_000_000)
+
+        benchmark(iterations: 100_000) {
+            let amountInWithFee = amountIn * 997
+            _ = amountInWithFee * reserveOut / (reserveIn * 1000 + amountInWithFee)
+        }
+    }
+
+    // 10,000 inputs over 64 registered selectors, every fourth input has an unknown selector
+    func testContractMethodDecoding_10kTransactions() {
+        let factories = ContractMethodFactories()
+        let methodFactories = (0..<64).map { TransferMethodFactory(methodId: ContractMethodHelper.methodId(signature: "transfer\($0)(address,uint256)")) }
+        factories.register(factories: methodFactories)
+
+        let inputs = (0..<10_000).map { index -> Data in
+            let methodId = index % 4 == 0 ? Data(repeating: 0xff, count: 4) : methodFactories[index % methodFactories.count].methodId
+            return ContractMethodHelper.encodedABI(methodId: methodId, arguments: [address, BigUInt(index)])
+        }
+
+        benchmark(iterations: 1) {
+            for input in inputs {
+                _ = factories.createMethod(input: input)
+            }
+        }
+    }
+
+}
+
+extension EncodingBenchmarkTests {
+
+    private class TransferMethodFactory: IContractMethodFactory {
+        let methodId: Data
+
+        init(methodId: Data) {
+            self.methodId = methodId
+        }
+
+        func createMethod(inputArguments: Data) throws -> ContractMethod {
+            _ = ContractMethodHelper.decodeABI(inputArguments: inputArguments, argumentTypes: [Address.self, BigUInt.self])
+            return EmptyMethod()
+        }
+    }
+
+}
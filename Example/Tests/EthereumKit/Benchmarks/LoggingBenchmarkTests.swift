@@ -0,0 +1,27 @@
+import XCTest
+import HsToolKit
+@testable import EthereumKit
+
+class LoggingBenchmarkTests: BenchmarkTestCase {
+    private let data = Data(repeating: 0xab, count: 256)
+
+    private func benchmarkDebugLogging(minLogLevel: Logger.Level) {
+        let logger = AsyncLogger(logger: Logger(minLogLevel: minLogLevel), minLogLevel: minLogLevel, maxPendingCount: 100_000)
+
+        benchmark(iterations: 10_000) {
+            logger.debug("Send RPC: \(data.toHexString())")
+        }
+
+        logger.flush()
+        XCTAssertEqual(logger.droppedCount, 0)
+    }
+
+    func testDebugLogging_Disabled() {
+        benchmarkDebugLogging(minLogLevel: .error)
+    }
+
+    func testDebugLogging_Enabled() {
+        benchmarkDebugLogging(minLogLevel: .debug)
+    }
+
+}
@@ -0,0 +1,68 @@
+import XCTest
+import RxSwift
+@testable import EthereumKit
+
+class RpcBenchmarkTests: BenchmarkTestCase {
+    private let address = Address(raw: Data(repeating: 0xab, count: 20))
+    private let transactionHash = Data(repeating: 0xcd, count: 32)
+
+    private var receiptJson: [String: Any] {
+        let log: [String: Any] = [
+            "address": address.hex,
+            "topics": [Data(repeating: 1, count: 32).toHexString(), Data(repeating: 2, count: 32).toHexString()],
+            "data": Data(repeating: 3, count: 32).toHexString(),
+            "blockHash": Data(repeating: 4, count: 32).toHexString(),
+            "blockNumber": "0x10",
+            "transactionHash": transactionHash.toHexString(),
+            "transactionIndex": "0x1",
+            "logIndex": "0x0",
+            "removed": false
+        ]
+
+        return [
+            "transactionHash": transactionHash.toHexString(),
+            "transactionIndex": "0x1",
+            "blockHash": Data(repeating: 4, count: 32).toHexString(),
+            "blockNumber": "0x10",
+            "from": address.hex,
+            "to": address.hex,
+            "effectiveGasPrice": "0x3b9aca00",
+            "cumulativeGasUsed": "0x5208",
+            "gasUsed": "0x5208",
+            "logs": Array(repeating: log, count: 10),
+            "logsBloom": Data(repeating: 0, count: 256).toHexString(),
+            "status": "0x1"
+        ]
+    }
+
+    func testParseReceiptResponse() throws {
+        let response: [String: Any] = ["jsonrpc": "2.0", "id": 1, "result": receiptJson]
+        let data = try JSONSerialization.data(withJSONObject: response)
+        let rpc = GetTransactionReceiptJsonRpc(transactionHash: transactionHash)
+
+        benchmark(iterations: 1_000) {
+            let jsonObject = try JSONSerialization.jsonObject(with: data)
+            let rpcResponse = try XCTUnwrap(JsonRpcResponse.response(jsonObject: jsonObject))
+            _ = try rpc.parse(response: rpcResponse)
+        }
+    }
+
+    func testReplayedGetTransactionReceipt() {
+        let recording = RpcRecording()
+        let rpc = GetTransactionReceiptJsonRpc(transactionHash: transactionHash)
+        recording.record(parameters: rpc.parameters(), response: ["jsonrpc": "2.0", "id": 1, "result": receiptJson])
+
+        let provider = ReplayRpcApiProvider(recording: recording)
+
+        benchmark(iterations: 1_000) {
+            var receipt: RpcTransactionReceipt?
+
+            // replay without latency completes synchronously on subscription
+            _ = provider.single(rpc: GetTransactionReceiptJsonRpc(transactionHash: transactionHash))
+                    .subscribe(onSuccess: { receipt = $0 })
+
+            XCTAssertNotNil(receipt)
+        }
+    }
+
+}
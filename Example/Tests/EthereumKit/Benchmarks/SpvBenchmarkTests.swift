@@ -0,0 +1,58 @@
+import XCTest
+import BigInt
+import OpenSslKit
+@testable import EthereumKit
+
+class SpvBenchmarkTests: BenchmarkTestCase {
+
+    private func frameCodec() -> FrameCodec {
+        let aes = Data(repeating: 1, count: 32)
+        let mac = Data(repeating: 2, count: 32)
+
+        return FrameCodec(
+                secrets: Secrets(aes: aes, mac: mac, token: Data(), egressMac: KeccakDigest(), ingressMac: KeccakDigest()),
+                helper: FrameCodecHelper(crypto: CryptoUtils.shared), encryptor: AESCipher(keySize: 256, key: aes), decryptor: AESCipher(keySize: 256, key: aes)
+        )
+    }
+
+    // egress state of the encoder mirrors ingress state of the decoder, so that encoded frames can be read back
+    private func benchmarkFrameRoundTrip(size: Int, iterations: Int) {
+        let encoder = frameCodec()
+        let decoder = frameCodec()
+        let frame = Frame(type: 0x13, payload: Data(repeating: 0xab, count: size), contextId: -1, allFramesTotalSize: -1)
+
+        benchmark(iterations: iterations) {
+            let encoded = encoder.encodeFrame(frame: frame)
+            let decoded = try XCTUnwrap(decoder.readFrame(from: encoded))
+            XCTAssertEqual(decoded.payload.count, size)
+        }
+    }
+
+    func testFrameRoundTrip_1kb() {
+        benchmarkFrameRoundTrip(size: 1_024, iterations: 1_000)
+    }
+
+    func testFrameRoundTrip_64kb() {
+        benchmarkFrameRoundTrip(size: 65_536, iterations: 100)
+    }
+
+    func testFrameRoundTrip_1mb() {
+        benchmarkFrameRoundTrip(size: 1_048_576, iterations: 10)
+    }
+
+    func testBlockHeadersDecoding_192Headers() {
+        let address = Address(raw: Data(repeating: 0xab, count: 20))
+        let hash = Data(repeating: 1, count: 32)
+        let headers: [Any] = (0..<192).map { height in
+            [hash, hash, address.raw, hash, hash, hash, Data(repeating: 0, count: 256), BigUInt(1_000_000), 12_000_000 + height,
+             30_000_000, 15_000_000, 1_600_000_000 + height * 13, Data(), hash, Data(repeating: 2, count: 8)] as [Any]
+        }
+        let message = RLP.encode([1, 1_000_000, headers] as [Any])
+
+        benchmark(iterations: 50) {
+            let decoded = try BlockHeadersMessage(data: message)
+            XCTAssertEqual(decoded.headers.count, headers.count)
+        }
+    }
+
+}
@@ -0,0 +1,59 @@
+import XCTest
+@testable import EthereumKit
+
+class StorageBenchmarkTests: BenchmarkTestCase {
+    private let address = Address(raw: Data(repeating: 0xab, count: 20))
+    private let tokens = (0..<100).map { Address(raw: Data(repeating: UInt8($0), count: 20)) }
+
+    private var directoryUrl: URL!
+    private var storage: TransactionStorage!
+
+    override func setUpWithError() throws {
+        try super.setUpWithError()
+
+        directoryUrl = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directoryUrl, withIntermediateDirectories: true)
+
+        storage = TransactionStorage(databaseDirectoryUrl: directoryUrl, databaseFileName: "transactions")
+
+        // 100,000 ERC20 transfers spread over 100 tokens
+        for batch in stride(from: 0, to: 100_000, by: 10_000) {
+            let hashes = (batch..<(batch + 10_000)).map { CryptoUtils.shared.sha3(Data(String($0).utf8)) }
+
+            storage.save(transactions: hashes.enumerated().map { index, hash in
+                Transaction(hash: hash, timestamp: batch + index, isFailed: false, blockNumber: batch + index, transactionIndex: 0, from: address, to: tokens[index % tokens.count])
+            })
+            storage.save(tags: hashes.enumerated().map { index, hash in
+                TransactionTagRecord(transactionHash: hash, tag: TransactionTag(type: .outgoing, protocol: .eip20, contractAddress: tokens[index % tokens.count]))
+            })
+        }
+    }
+
+    override func tearDownWithError() throws {
+        storage = nil
+
+        if let directoryUrl = directoryUrl {
+            try? FileManager.default.removeItem(at: directoryUrl)
+        }
+
+        try super.tearDownWithError()
+    }
+
+    func testTokenHistoryFirstPage() {
+        let tagQueries = [TransactionTagQuery(contractAddress: tokens[42])]
+
+        benchmark(iterations: 100) {
+            XCTAssertEqual(storage.transactionsBefore(tagQueries: tagQueries, hash: nil, limit: 20).count, 20)
+        }
+    }
+
+    func testTokenHistoryNextPage() {
+        let tagQueries = [TransactionTagQuery(contractAddress: tokens[42])]
+        let fromHash = storage.transactionsBefore(tagQueries: tagQueries, hash: nil, limit: 500).last?.hash
+
+        benchmark(iterations: 100) {
+            XCTAssertEqual(storage.transactionsBefore(tagQueries: tagQueries, hash: fromHash, limit: 20).count, 20)
+        }
+    }
+
+}
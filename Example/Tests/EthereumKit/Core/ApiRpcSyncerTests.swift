@@ -0,0 +1,123 @@
+import XCTest
+import RxSwift
+import HsToolKit
+@testable import EthereumKit
+
+class ApiRpcSyncerTests: XCTestCase {
+    private let iterations = 200
+
+    private var provider: StubRpcApiProvider!
+    private var delegate: RecordingDelegate!
+    private var syncer: ApiRpcSyncer!
+
+    override func setUp() {
+        super.setUp()
+
+        provider = StubRpcApiProvider()
+        delegate = RecordingDelegate()
+        syncer = ApiRpcSyncer(rpcApiProvider: provider, reachabilityManager: ReachabilityManager(), syncInterval: 3600)
+        syncer.delegate = delegate
+    }
+
+    override func tearDown() {
+        syncer = nil
+        delegate = nil
+        provider = nil
+
+        super.tearDown()
+    }
+
+    private func waitUntil(_ condition: () -> Bool) {
+        let deadline = Date().addingTimeInterval(5)
+
+        while !condition() && Date() < deadline {
+            usleep(1000)
+        }
+    }
+
+    func testStartStop_FromManyThreads_DeliversStatesInWriteOrder() {
+        DispatchQueue.concurrentPerform(iterations: iterations) { index in
+            if index % 2 == 0 {
+                syncer.start()
+            } else {
+                syncer.stop()
+            }
+        }
+
+        syncer.stop()
+
+        let finalState = SyncerState.notReady(error: Kit.SyncError.notStarted)
+        waitUntil { delegate.states.last == finalState }
+
+        let states = delegate.states
+
+        XCTAssertEqual(syncer.state, finalState)
+        XCTAssertEqual(states.last, finalState)
+
+        // a change is only notified when the state differs from the previous one
+        for (previous, next) in zip(states, states.dropFirst()) {
+            XCTAssertNotEqual(previous, next)
+        }
+    }
+
+    func testFireTimer_FromManyThreads_DeliversIncreasingBlockHeights() {
+        DispatchQueue.concurrentPerform(iterations: iterations) { _ in
+            syncer.onFireTimer()
+        }
+
+        waitUntil { delegate.lastBlockHeights.last == iterations }
+
+        let heights = delegate.lastBlockHeights
+
+        XCTAssertEqual(heights.last, iterations)
+        XCTAssertEqual(heights, heights.sorted())
+        XCTAssertEqual(Set(heights).count, heights.count)
+    }
+
+}
+
+extension ApiRpcSyncerTests {
+
+    private class StubRpcApiProvider: IRpcApiProvider {
+        private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.tests.stub-rpc-api-provider")
+        private var blockHeight = 0
+
+        var source: String {
+            "stub"
+        }
+
+        func single<T>(rpc: JsonRpc<T>) -> Single<T> {
+            let blockHeight: Int = queue.sync {
+                self.blockHeight += 1
+                return self.blockHeight
+            }
+
+            // responses are completed in random order
+            return Single.just(blockHeight as! T)
+                    .delay(.microseconds(Int.random(in: 0..<1000)), scheduler: ConcurrentDispatchQueueScheduler(qos: .utility))
+        }
+    }
+
+    private class RecordingDelegate: IRpcSyncerDelegate {
+        private let queue = DispatchQueue(label: "io.horizontal-systems.ethereum-kit.tests.recording-delegate")
+        private var _states = [SyncerState]()
+        private var _lastBlockHeights = [Int]()
+
+        var states: [SyncerState] {
+            queue.sync { _states }
+        }
+
+        var lastBlockHeights: [Int] {
+            queue.sync { _lastBlockHeights }
+        }
+
+        func didUpdate(state: SyncerState) {
+            queue.sync { _states.append(state) }
+        }
+
+        func didUpdate(lastBlockHeight: Int) {
+            queue.sync { _lastBlockHeights.append(lastBlockHeight) }
+        }
+    }
+
+}
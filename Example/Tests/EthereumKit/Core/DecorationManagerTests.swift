@@ -0,0 +1,99 @@
+import XCTest
+@testable import EthereumKit
+
+class DecorationManagerTests: XCTestCase {
+    private let userAddress = Address(raw: Data(repeating: 0xab, count: 20))
+
+    private var directoryUrl: URL!
+    private var decorationManager: DecorationManager!
+
+    override func setUp() {
+        super.setUp()
+
+        directoryUrl = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString)
+        try! FileManager.default.createDirectory(at: directoryUrl, withIntermediateDirectories: true)
+
+        let storage = TransactionStorage(databaseDirectoryUrl: directoryUrl, databaseFileName: "transactions")
+        decorationManager = DecorationManager(userAddress: userAddress, storage: storage)
+    }
+
+    override func tearDown() {
+        decorationManager = nil
+        try? FileManager.default.removeItem(at: directoryUrl)
+
+        super.tearDown()
+    }
+
+    private func transactions(count: Int) -> [Transaction] {
+        (0..<count).map { index in
+            Transaction(hash: Data(repeating: UInt8(index % 256), count: 31) + Data([UInt8(index / 256)]), timestamp: 1, isFailed: false, input: Data([0xa9, 0x05, 0x9c, 0xbb]))
+        }
+    }
+
+    func testNotThreadSafeDecorator_CalledSerially() {
+        let decorator = RecordingMethodDecorator(isThreadSafe: false)
+        decorationManager.add(methodDecorator: decorator)
+
+        _ = decorationManager.decorate(transactions: transactions(count: DecorationManager.concurrentDecodingThreshold * 2))
+
+        XCTAssertEqual(decorator.callCount, DecorationManager.concurrentDecodingThreshold * 2)
+        XCTAssertEqual(decorator.maxConcurrentCallCount, 1)
+    }
+
+    func testNotThreadSafeDecorator_WithThreadSafeOne_CalledSerially() {
+        let threadSafeDecorator = RecordingMethodDecorator(isThreadSafe: true)
+        let decorator = RecordingMethodDecorator(isThreadSafe: false)
+        decorationManager.add(methodDecorator: threadSafeDecorator)
+        decorationManager.add(methodDecorator: decorator)
+
+        _ = decorationManager.decorate(transactions: transactions(count: DecorationManager.concurrentDecodingThreshold * 2))
+
+        XCTAssertEqual(decorator.callCount, DecorationManager.concurrentDecodingThreshold * 2)
+        XCTAssertEqual(decorator.maxConcurrentCallCount, 1)
+    }
+
+    func testThreadSafeDecorator_CalledForEachInput() {
+        let decorator = RecordingMethodDecorator(isThreadSafe: true)
+        decorationManager.add(methodDecorator: decorator)
+
+        let fullTransactions = decorationManager.decorate(transactions: transactions(count: DecorationManager.concurrentDecodingThreshold * 2))
+
+        XCTAssertEqual(fullTransactions.count, DecorationManager.concurrentDecodingThreshold * 2)
+        XCTAssertEqual(decorator.callCount, DecorationManager.concurrentDecodingThreshold * 2)
+    }
+
+}
+
+extension DecorationManagerTests {
+
+    private class RecordingMethodDecorator: IMethodDecorator {
+        let isThreadSafe: Bool
+
+        private let lock = NSLock()
+        private var concurrentCallCount = 0
+        private(set) var callCount = 0
+        private(set) var maxConcurrentCallCount = 0
+
+        init(isThreadSafe: Bool) {
+            self.isThreadSafe = isThreadSafe
+        }
+
+        func contractMethod(input: Data) -> ContractMethod? {
+            lock.lock()
+            callCount += 1
+            concurrentCallCount += 1
+            maxConcurrentCallCount = max(maxConcurrentCallCount, concurrentCallCount)
+            lock.unlock()
+
+            // widens the window in which concurrent calls overlap
+            usleep(100)
+
+            lock.lock()
+            concurrentCallCount -= 1
+            lock.unlock()
+
+            return nil
+        }
+    }
+
+}
@@ -0,0 +1,201 @@
+import XCTest
+import BigInt
+import RxSwift
+import Cuckoo
+@testable import EthereumKit
+
+class MulticallProviderTests: XCTestCase {
+    private let contractAddress = Address(raw: Data(repeating: 0xca, count: 20))
+    private let firstAddress = Address(raw: Data(repeating: 0x11, count: 20))
+    private let secondAddress = Address(raw: Data(repeating: 0x22, count: 20))
+
+    private var mockBlockchain: MockIBlockchain!
+    private var provider: MulticallProvider!
+    private var disposeBag: DisposeBag!
+
+    override func setUp() {
+        super.setUp()
+
+        mockBlockchain = MockIBlockchain()
+        provider = MulticallProvider(blockchain: mockBlockchain, contractAddress: contractAddress)
+        disposeBag = DisposeBag()
+    }
+
+    override func tearDown() {
+        disposeBag = nil
+        provider = nil
+        mockBlockchain = nil
+
+        super.tearDown()
+    }
+
+    private func word(_ value: Int) -> Data {
+        Data(repeating: 0, count: 24) + withUnsafeBytes(of: UInt64(value).bigEndian) { Data($0) }
+    }
+
+    private func word(_ data: Data, rightPadded: Bool = false) -> Data {
+        let padding = Data(repeating: 0, count: 32 - data.count)
+        return rightPadded ? data + padding : padding + data
+    }
+
+    // (bool success, bytes returnData)[] with results (true, 0xaabbcc) and (false, 0x)
+    private var encodedResults: Data {
+        ContractMethodHelper.encodedABI(methodId: Data(), arguments: [[
+            ContractMethodHelper.StructParameter([true, Data(hex: "aabbcc")!]),
+            ContractMethodHelper.StructParameter([false, Data()])
+        ]])
+    }
+
+    private func replacing(word index: Int, in data: Data, with newWord: Data) -> Data {
+        var data = data
+        data.replaceSubrange((index * 32)..<((index + 1) * 32), with: newWord)
+        return data
+    }
+
+    func testEncode() {
+        let calls = [
+            MulticallProvider.Call(contractAddress: firstAddress, data: Data(hex: "aabbcc")!),
+            MulticallProvider.Call(contractAddress: secondAddress, data: Data())
+        ]
+
+        var expected = Data(hex: "bce38bd7")!
+        expected += word(0)                                     // requireSuccess
+        expected += word(0x40)                                  // offset of calls
+        expected += word(2)                                     // calls count
+        expected += word(0x40) + word(0xc0)                     // offsets of calls, relative to the first offset
+        expected += word(firstAddress.raw) + word(0x40) + word(3) + word(Data(hex: "aabbcc")!, rightPadded: true)
+        expected += word(secondAddress.raw) + word(0x40) + word(0)
+
+        XCTAssertEqual(MulticallProvider.TryAggregateMethod(calls: calls).encodedABI(), expected)
+    }
+
+    func testDecode() throws {
+        let results = try MulticallProvider.TryAggregateMethod.decode(data: encodedResults, count: 2)
+
+        XCTAssertEqual(results, [Data(hex: "aabbcc")!, nil])
+    }
+
+    func testDecode_Empty() throws {
+        let data = ContractMethodHelper.encodedABI(methodId: Data(), arguments: [[ContractMethodHelper.StructParameter]()])
+
+        XCTAssertEqual(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 0), [])
+    }
+
+    func testDecode_CountMismatch() {
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: encodedResults, count: 3))
+    }
+
+    func testDecode_Truncated() {
+        let data = encodedResults
+
+        for count in [0, 31, 64, 96, data.count - 32, data.count - 1] {
+            XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data.prefix(count), count: 2), "truncated to \(count)")
+        }
+    }
+
+    func testDecode_ArrayOffsetOutOfRange() {
+        let data = replacing(word: 0, in: encodedResults, with: word(encodedResults.count))
+
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 2))
+    }
+
+    func testDecode_ArrayLengthOutOfRange() {
+        let data = replacing(word: 1, in: encodedResults, with: word(Int.max))
+
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 2))
+    }
+
+    func testDecode_ElementOffsetOutOfRange() {
+        let data = replacing(word: 3, in: encodedResults, with: word(encodedResults.count))
+
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 2))
+    }
+
+    func testDecode_NegativeElementOffset() {
+        let data = replacing(word: 2, in: encodedResults, with: Data(repeating: 0, count: 24) + Data(repeating: 0xff, count: 8))
+
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 2))
+    }
+
+    func testDecode_OversizedElementOffset() {
+        // the low 8 bytes hold a valid offset, so the word is accepted only if the high bytes are ignored
+        var oversized = word(0x40)
+        oversized[0] = 1
+        let data = replacing(word: 2, in: encodedResults, with: oversized)
+
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 2))
+    }
+
+    func testDecode_BytesOffsetOutOfRange() {
+        // word 5 is the offset of returnData of the first result
+        let data = replacing(word: 5, in: encodedResults, with: word(encodedResults.count))
+
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 2))
+    }
+
+    func testDecode_BytesLengthOutOfRange() {
+        let data = replacing(word: 6, in: encodedResults, with: word(Int.max))
+
+        XCTAssertThrowsError(try MulticallProvider.TryAggregateMethod.decode(data: data, count: 2))
+    }
+
+    // balance of an address is 1000 + its first byte, nonce is its first byte
+    private func stubAccountStates(callData: @escaping (Data) -> (), nonceAddresses: @escaping (String) -> ()) {
+        stub(mockBlockchain) { mock in
+            when(mock.lastBlockHeight.get).thenReturn(100)
+            when(mock.call(contractAddress: any(), data: any(), defaultBlockParameter: any())).then { _, data, _ in
+                callData(data)
+
+                let results = [self.firstAddress, self.secondAddress].map {
+                    ContractMethodHelper.StructParameter([true, self.word(1000 + Int($0.raw[0]))])
+                }
+                return Single.just(ContractMethodHelper.encodedABI(methodId: Data(), arguments: [results]))
+            }
+            when(mock.rpcSingle(rpcRequest: any(JsonRpc<Int>.self))).then { request in
+                let address = (request.parameters()["params"] as? [Any])?.first as? String ?? ""
+                nonceAddresses(address)
+
+                return Single.just(Int(try! Address(hex: address).raw[0]))
+            }
+        }
+    }
+
+    func testAccountStates_DuplicateAddresses_RequestedOnce() {
+        var callDatas = [Data]()
+        var nonceAddresses = [String]()
+        stubAccountStates(callData: { callDatas.append($0) }, nonceAddresses: { nonceAddresses.append($0) })
+
+        var states: [Address: AccountState]?
+
+        provider.accountStatesSingle(addresses: [firstAddress, secondAddress, firstAddress, secondAddress, firstAddress])
+                .subscribe(onSuccess: { states = $0 })
+                .disposed(by: disposeBag)
+
+        let expectedCalls = [firstAddress, secondAddress].map {
+            MulticallProvider.Call(contractAddress: contractAddress, data: MulticallProvider.GetEthBalanceMethod(address: $0).encodedABI())
+        }
+
+        XCTAssertEqual(callDatas, [MulticallProvider.TryAggregateMethod(calls: expectedCalls).encodedABI()])
+        XCTAssertEqual(nonceAddresses.sorted(), [firstAddress.hex, secondAddress.hex])
+
+        XCTAssertEqual(states?.count, 2)
+        XCTAssertEqual(states?[firstAddress]?.balance, 1000 + 0x11)
+        XCTAssertEqual(states?[firstAddress]?.nonce, 0x11)
+        XCTAssertEqual(states?[secondAddress]?.balance, 1000 + 0x22)
+        XCTAssertEqual(states?[secondAddress]?.nonce, 0x22)
+    }
+
+    func testAccountStates_PinnedToLastBlock() {
+        stubAccountStates(callData: { _ in }, nonceAddresses: { _ in })
+
+        provider.accountStatesSingle(addresses: [firstAddress, secondAddress, firstAddress])
+                .subscribe()
+                .disposed(by: disposeBag)
+
+        let blockParameterCaptor = ArgumentCaptor<DefaultBlockParameter>()
+        verify(mockBlockchain).call(contractAddress: equal(to: contractAddress), data: any(), defaultBlockParameter: blockParameterCaptor.capture())
+
+        XCTAssertEqual(blockParameterCaptor.value?.raw, DefaultBlockParameter.blockNumber(value: 100).raw)
+    }
+
+}
@@ -0,0 +1,178 @@
+import XCTest
+import RxSwift
+import Cuckoo
+@testable import EthereumKit
+
+class PendingTransactionSyncerTests: XCTestCase {
+    private let syncerId = "pending-transaction-syncer"
+    private let includedHash = Data(repeating: 1, count: 32)
+    private let notIncludedHash = Data(repeating: 2, count: 32)
+
+    private var directoryUrl: URL!
+    private var mockBlockchain: MockIBlockchain!
+    private var storage: TransactionStorage!
+    private var syncerStateStorage: TransactionSyncerStateStorage!
+    private var syncer: PendingTransactionSyncer!
+    private var disposeBag: DisposeBag!
+
+    private var requestedReceiptHashes = [Data]()
+
+    override func setUp() {
+        super.setUp()
+
+        directoryUrl = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString)
+        try! FileManager.default.createDirectory(at: directoryUrl, withIntermediateDirectories: true)
+
+        mockBlockchain = MockIBlockchain()
+        storage = TransactionStorage(databaseDirectoryUrl: directoryUrl, databaseFileName: "transactions")
+        syncerStateStorage = TransactionSyncerStateStorage(databaseDirectoryUrl: directoryUrl, databaseFileName: "transaction-syncer-states")
+        syncer = PendingTransactionSyncer(blockchain: mockBlockchain, storage: storage, syncerStateStorage: syncerStateStorage)
+        disposeBag = DisposeBag()
+        requestedReceiptHashes = []
+
+        storage.save(transactions: [
+            Transaction(hash: includedHash, timestamp: 1, isFailed: false),
+            Transaction(hash: notIncludedHash, timestamp: 1, isFailed: false)
+        ])
+
+        stub(mockBlockchain) { mock in
+            when(mock.lastBlockHeight.get).thenReturn(102)
+            when(mock.getBlock(blockNumber: any())).then { [unowned self] blockNumber in
+                Single.just(self.block(number: blockNumber, transactionHashes: blockNumber == 101 ? [self.includedHash] : []))
+            }
+            when(mock.transactionReceiptSingle(transactionHash: any())).then { [unowned self] hash in
+                self.requestedReceiptHashes.append(hash)
+                return Single.just(self.receipt(hash: hash, blockNumber: 101))
+            }
+        }
+    }
+
+    override func tearDown() {
+        disposeBag = nil
+        syncer = nil
+        syncerStateStorage = nil
+        storage = nil
+        mockBlockchain = nil
+        try? FileManager.default.removeItem(at: directoryUrl)
+
+        super.tearDown()
+    }
+
+    private func hex(_ value: Int) -> String {
+        "0x" + String(value, radix: 16)
+    }
+
+    private func block(number: Int, transactionHashes: [Data]) -> RpcBlock {
+        try! RpcBlock(JSON: [
+            "hash": "0x" + Data(repeating: UInt8(number % 256), count: 32).toHexString(),
+            "number": hex(number),
+            "timestamp": hex(1000 + number),
+            "transactions": transactionHashes.map { "0x" + $0.toHexString() }
+        ])
+    }
+
+    private func receipt(hash: Data, blockNumber: Int) -> RpcTransactionReceipt {
+        try! RpcTransactionReceipt(JSON: [
+            "transactionHash": "0x" + hash.toHexString(),
+            "transactionIndex": "0x0",
+            "blockHash": "0x" + Data(repeating: UInt8(blockNumber % 256), count: 32).toHexString(),
+            "blockNumber": hex(blockNumber),
+            "from": "0x" + String(repeating: "ab", count: 20),
+            "cumulativeGasUsed": "0x5208",
+            "gasUsed": "0x5208",
+            "logs": [[String: Any]](),
+            "logsBloom": "0x" + String(repeating: "00", count: 256),
+            "status": "0x1"
+        ])
+    }
+
+    private func saveCheckpoint(lastBlockNumber: Int) {
+        try! syncerStateStorage.save(syncerState: TransactionSyncerState(syncerId: syncerId, lastBlockNumber: lastBlockNumber))
+    }
+
+    private var checkpoint: Int? {
+        (try? syncerStateStorage.syncerState(syncerId: syncerId))?.lastBlockNumber
+    }
+
+    private func syncedTransactions() -> [Transaction] {
+        let e = expectation(description: "Transactions synced")
+        var transactions = [Transaction]()
+
+        syncer.transactionsSingle()
+                .subscribe(onSuccess: { result in
+                    transactions = result.0
+                    e.fulfill()
+                })
+                .disposed(by: disposeBag)
+
+        waitForExpectations(timeout: 2)
+
+        return transactions
+    }
+
+    func testBlockScan_ResolvesOnlyIncludedTransactions() {
+        saveCheckpoint(lastBlockNumber: 100)
+
+        let transactions = syncedTransactions()
+
+        XCTAssertEqual(transactions.map { $0.hash }, [includedHash])
+        XCTAssertEqual(transactions.first?.blockNumber, 101)
+        XCTAssertEqual(transactions.first?.timestamp, 1101)
+        XCTAssertEqual(requestedReceiptHashes, [includedHash])
+    }
+
+    func testBlockScan_ScansFromLastCheckedBlock() {
+        saveCheckpoint(lastBlockNumber: 100)
+
+        _ = syncedTransactions()
+
+        verify(mockBlockchain).getBlock(blockNumber: 100)
+        verify(mockBlockchain).getBlock(blockNumber: 101)
+        verify(mockBlockchain).getBlock(blockNumber: 102)
+        verify(mockBlockchain, never()).getBlock(blockNumber: 99)
+    }
+
+    func testReceiptFallback_WithoutCheckpoint() {
+        let transactions = syncedTransactions()
+
+        XCTAssertEqual(Set(transactions.map { $0.hash }), [includedHash, notIncludedHash])
+        XCTAssertEqual(Set(requestedReceiptHashes), [includedHash, notIncludedHash])
+        verify(mockBlockchain, never()).getBlock(blockNumber: any())
+    }
+
+    func testReceiptFallback_TooManyBlocksToScan() {
+        saveCheckpoint(lastBlockNumber: 50)
+
+        _ = syncedTransactions()
+
+        XCTAssertEqual(Set(requestedReceiptHashes), [includedHash, notIncludedHash])
+        verify(mockBlockchain, never()).getBlock(blockNumber: any())
+    }
+
+    func testCheckpoint_SavedOnlyOnSaveCheckpoint() {
+        saveCheckpoint(lastBlockNumber: 100)
+
+        _ = syncedTransactions()
+
+        XCTAssertEqual(checkpoint, 100)
+
+        syncer.saveCheckpoint()
+
+        XCTAssertEqual(checkpoint, 102)
+    }
+
+    func testCheckpoint_NotSavedOnError() {
+        saveCheckpoint(lastBlockNumber: 100)
+
+        stub(mockBlockchain) { mock in
+            when(mock.getBlock(blockNumber: any())).thenReturn(Single.error(Kit.KitError.weakReference))
+        }
+
+        XCTAssertEqual(syncedTransactions().count, 0)
+
+        syncer.saveCheckpoint()
+
+        XCTAssertEqual(checkpoint, 100)
+    }
+
+}
@@ -0,0 +1,113 @@
+import XCTest
+import RxSwift
+@testable import EthereumKit
+
+class RpcRequestCoalescerTests: XCTestCase {
+    private var coalescer: RpcRequestCoalescer!
+    private var subjects: [PublishSubject<Any>]!
+    private var disposeBag: DisposeBag!
+
+    override func setUp() {
+        super.setUp()
+
+        coalescer = RpcRequestCoalescer()
+        subjects = []
+        disposeBag = DisposeBag()
+    }
+
+    override func tearDown() {
+        disposeBag = nil
+        subjects = nil
+        coalescer = nil
+
+        super.tearDown()
+    }
+
+    // each request stays in flight until its subject emits
+    private func single(key: String = "eth_blockNumber") -> Single<Any> {
+        coalescer.single(key: key) { [unowned self] in
+            let subject = PublishSubject<Any>()
+            self.subjects.append(subject)
+            return subject.asSingle()
+        }
+    }
+
+    private func complete(_ subject: PublishSubject<Any>, result: Any) {
+        subject.onNext(result)
+        subject.onCompleted()
+    }
+
+    func testIdenticalRequests_ShareOneRequest() {
+        var results = [String]()
+
+        for _ in 0..<3 {
+            single()
+                    .subscribe(onSuccess: { results.append($0 as! String) })
+                    .disposed(by: disposeBag)
+        }
+
+        XCTAssertEqual(subjects.count, 1)
+        XCTAssertEqual(coalescer.inFlightCount, 1)
+
+        complete(subjects[0], result: "0x10")
+
+        XCTAssertEqual(results, ["0x10", "0x10", "0x10"])
+        XCTAssertEqual(coalescer.coalescedCount, 2)
+        XCTAssertEqual(coalescer.inFlightCount, 0)
+    }
+
+    func testDifferentRequests_NotShared() {
+        single(key: "a").subscribe().disposed(by: disposeBag)
+        single(key: "b").subscribe().disposed(by: disposeBag)
+
+        XCTAssertEqual(subjects.count, 2)
+        XCTAssertEqual(coalescer.coalescedCount, 0)
+    }
+
+    func testCompletedRequest_NotReused() {
+        single().subscribe().disposed(by: disposeBag)
+        complete(subjects[0], result: "0x10")
+
+        var result: String?
+        single()
+                .subscribe(onSuccess: { result = $0 as? String })
+                .disposed(by: disposeBag)
+
+        XCTAssertEqual(subjects.count, 2)
+        XCTAssertNil(result)
+
+        complete(subjects[1], result: "0x11")
+
+        XCTAssertEqual(result, "0x11")
+    }
+
+    func testError_SharedAndEntryRemoved() {
+        var errorCount = 0
+
+        for _ in 0..<2 {
+            single()
+                    .subscribe(onError: { _ in errorCount += 1 })
+                    .disposed(by: disposeBag)
+        }
+
+        subjects[0].onError(TestError())
+
+        XCTAssertEqual(errorCount, 2)
+        XCTAssertEqual(coalescer.inFlightCount, 0)
+
+        single().subscribe().disposed(by: disposeBag)
+
+        XCTAssertEqual(subjects.count, 2)
+    }
+
+    func testDisposedRequest_EntryRemoved() {
+        let disposable = single().subscribe()
+
+        XCTAssertEqual(coalescer.inFlightCount, 1)
+
+        disposable.dispose()
+
+        XCTAssertEqual(coalescer.inFlightCount, 0)
+    }
+
+}
@@ -0,0 +1,152 @@
+import XCTest
+@testable import EthereumKit
+
+class RpcResponseCacheTests: XCTestCase {
+    private var cache: RpcResponseCache!
+
+    override func setUp() {
+        super.setUp()
+
+        cache = RpcResponseCache(maxCount: 10, finalityDepth: 12)
+    }
+
+    override func tearDown() {
+        cache = nil
+
+        super.tearDown()
+    }
+
+    private func parameters(method: String, params: [Any], id: Int = 1) -> [String: Any] {
+        ["jsonrpc": "2.0", "method": method, "params": params, "id": id]
+    }
+
+    private func response(result: Any) -> [String: Any] {
+        ["jsonrpc": "2.0", "id": 1, "result": result]
+    }
+
+    private func callParameters(blockParameter: String, id: Int = 1) -> [String: Any] {
+        parameters(method: "eth_call", params: [["to": "0x01", "data": "0x02"], blockParameter], id: id)
+    }
+
+    private func receiveBlockNumber(_ blockNumber: Int) {
+        cache.didReceive(response: response(result: "0x" + String(blockNumber, radix: 16)), parameters: parameters(method: "eth_blockNumber", params: []), requestBlockHeight: cache.lastBlockHeight)
+    }
+
+    private func result(parameters: [String: Any]) -> String? {
+        (cache.response(parameters: parameters) as? [String: Any])?["result"] as? String
+    }
+
+    func testBlockNumber() {
+        receiveBlockNumber(100)
+        receiveBlockNumber(90)
+
+        XCTAssertEqual(cache.lastBlockHeight, 100)
+    }
+
+    func testPinned_BlockByHash_BeforeBlockHeight() {
+        let parameters = self.parameters(method: "eth_getBlockByHash", params: ["0xabcd", false])
+        cache.didReceive(response: response(result: ["number": "0x1"]), parameters: parameters, requestBlockHeight: nil)
+
+        XCTAssertNotNil(cache.response(parameters: parameters))
+    }
+
+    func testPinned_FinalizedBlock_KeptOnNewBlock() {
+        receiveBlockNumber(100)
+        cache.didReceive(response: response(result: "0x01"), parameters: callParameters(blockParameter: "0x58"), requestBlockHeight: 100)
+        receiveBlockNumber(101)
+
+        XCTAssertEqual(result(parameters: callParameters(blockParameter: "0x58", id: 2)), "0x01")
+    }
+
+    func testHead_NotFinalizedBlock_DroppedOnNewBlock() {
+        receiveBlockNumber(100)
+        cache.didReceive(response: response(result: "0x01"), parameters: callParameters(blockParameter: "0x59"), requestBlockHeight: 100)
+
+        XCTAssertEqual(result(parameters: callParameters(blockParameter: "0x59")), "0x01")
+
+        receiveBlockNumber(101)
+
+        XCTAssertNil(cache.response(parameters: callParameters(blockParameter: "0x59")))
+    }
+
+    func testHead_Latest_DroppedOnNewBlock() {
+        receiveBlockNumber(100)
+        cache.didReceive(response: response(result: "0x01"), parameters: callParameters(blockParameter: "latest"), requestBlockHeight: 100)
+
+        XCTAssertEqual(result(parameters: callParameters(blockParameter: "latest")), "0x01")
+
+        receiveBlockNumber(101)
+
+        XCTAssertNil(cache.response(parameters: callParameters(blockParameter: "latest")))
+    }
+
+    func testHead_NotKeptBeforeBlockHeight() {
+        cache.didReceive(response: response(result: "0x01"), parameters: callParameters(blockParameter: "latest"), requestBlockHeight: nil)
+
+        XCTAssertNil(cache.response(parameters: callParameters(blockParameter: "latest")))
+    }
+
+    func testHead_NotKeptWhenBlockChangedDuringRequest() {
+        receiveBlockNumber(100)
+        receiveBlockNumber(101)
+        cache.didReceive(response: response(result: "0x01"), parameters: callParameters(blockParameter: "latest"), requestBlockHeight: 100)
+
+        XCTAssertNil(cache.response(parameters: callParameters(blockParameter: "latest")))
+    }
+
+    func testHead_Expired() {
+        cache = RpcResponseCache(maxCount: 10, finalityDepth: 12, headTimeToLive: 0)
+        receiveBlockNumber(100)
+        cache.didReceive(response: response(result: "0x01"), parameters: callParameters(blockParameter: "latest"), requestBlockHeight: 100)
+
+        XCTAssertNil(cache.response(parameters: callParameters(blockParameter: "latest")))
+    }
+
+    func testPinned_NotExpired() {
+        cache = RpcResponseCache(maxCount: 10, finalityDepth: 12, headTimeToLive: 0)
+        receiveBlockNumber(100)
+        cache.didReceive(response: response(result: "0x01"), parameters: callParameters(blockParameter: "0x58"), requestBlockHeight: 100)
+
+        XCTAssertEqual(result(parameters: callParameters(blockParameter: "0x58")), "0x01")
+    }
+
+    func testErrorAndNullNotCached() {
+        let parameters = self.parameters(method: "eth_getTransactionReceipt", params: ["0xabcd"])
+        receiveBlockNumber(100)
+
+        let error: [String: Any] = ["code": -32000, "message": "error"]
+        let errorResponse: [String: Any] = ["jsonrpc": "2.0", "id": 1, "error": error]
+
+        cache.didReceive(response: errorResponse, parameters: parameters, requestBlockHeight: 100)
+        XCTAssertNil(cache.response(parameters: parameters))
+
+        cache.didReceive(response: response(result: NSNull()), parameters: parameters, requestBlockHeight: 100)
+        XCTAssertNil(cache.response(parameters: parameters))
+    }
+
+    func testReceipt_PinnedOnlyWhenFinalized() {
+        let finalized = parameters(method: "eth_getTransactionReceipt", params: ["0x01"])
+        let recent = parameters(method: "eth_getTransactionReceipt", params: ["0x02"])
+        receiveBlockNumber(100)
+
+        cache.didReceive(response: response(result: ["blockNumber": "0x58"]), parameters: finalized, requestBlockHeight: 100)
+        cache.didReceive(response: response(result: ["blockNumber": "0x59"]), parameters: recent, requestBlockHeight: 100)
+
+        XCTAssertNotNil(cache.response(parameters: finalized))
+        XCTAssertNil(cache.response(parameters: recent))
+    }
+
+    func testPinned_EvictedBySize() {
+        cache = RpcResponseCache(maxCount: 2, finalityDepth: 12)
+
+        let hashes = ["0x01", "0x02", "0x03"]
+
+        for hash in hashes {
+            cache.didReceive(response: response(result: ["hash": hash]), parameters: parameters(method: "eth_getBlockByHash", params: [hash, false]), requestBlockHeight: nil)
+        }
+
+        XCTAssertNil(cache.response(parameters: parameters(method: "eth_getBlockByHash", params: ["0x01", false])))
+        XCTAssertNotNil(cache.response(parameters: parameters(method: "eth_getBlockByHash", params: ["0x03", false])))
+    }
+
+}
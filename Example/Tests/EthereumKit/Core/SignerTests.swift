@@ -0,0 +1,64 @@
+import XCTest
+import BigInt
+@testable import EthereumKit
+
+class SignerTests: XCTestCase {
+    private let privateKey = Data(repeating: 0x4c, count: 32)
+    private let to = Address(raw: Data(repeating: 0x35, count: 20))
+
+    // large enough to be signed concurrently
+    private let count = 64
+
+    private func rawTransactions(gasPrice: (Int) -> GasPrice) -> [RawTransaction] {
+        (0..<count).map { nonce in
+            RawTransaction(gasPrice: gasPrice(nonce), gasLimit: 21_000, to: to, value: BigUInt(nonce + 1), data: Data(), nonce: nonce)
+        }
+    }
+
+    private func assertEqual(_ lhs: [Signature], _ rhs: [Signature], file: StaticString = #file, line: UInt = #line) {
+        XCTAssertEqual(lhs.count, rhs.count, file: file, line: line)
+
+        for (left, right) in zip(lhs, rhs) {
+            XCTAssertEqual(left.v, right.v, file: file, line: line)
+            XCTAssertEqual(left.r, right.r, file: file, line: line)
+            XCTAssertEqual(left.s, right.s, file: file, line: line)
+        }
+    }
+
+    func testTransactionSignatures_Legacy_EqualOneByOneInOrder() throws {
+        let signer = TransactionSigner(chain: .ethereum, privateKey: privateKey)
+        let rawTransactions = self.rawTransactions { .legacy(gasPrice: 1_000_000_000 + $0) }
+
+        let signatures = try signer.signatures(rawTransactions: rawTransactions)
+        let expected = try rawTransactions.map { try signer.signature(rawTransaction: $0) }
+
+        assertEqual(signatures, expected)
+    }
+
+    func testTransactionSignatures_Eip1559_EqualOneByOneInOrder() throws {
+        let signer = TransactionSigner(chain: .ethereum, privateKey: privateKey)
+        let rawTransactions = self.rawTransactions { .eip1559(maxFeePerGas: 2_000_000_000 + $0, maxPriorityFeePerGas: 1_000_000_000) }
+
+        let signatures = try signer.signatures(rawTransactions: rawTransactions)
+        let expected = try rawTransactions.map { try signer.signature(rawTransaction: $0) }
+
+        assertEqual(signatures, expected)
+    }
+
+    func testMessageSignatures_EqualOneByOneInOrder() throws {
+        let signer = EthSigner(privateKey: privateKey, cryptoUtils: CryptoUtils.shared)
+        let messages = (0..<count).map { "message \($0)".data(using: .utf8)! }
+
+        let signatures = try signer.sign(messages: messages)
+        let expected = try messages.map { try signer.sign(message: $0) }
+
+        XCTAssertEqual(signatures, expected)
+    }
+
+    func testSignatures_Empty() throws {
+        let signer = TransactionSigner(chain: .ethereum, privateKey: privateKey)
+
+        XCTAssertTrue(try signer.signatures(rawTransactions: []).isEmpty)
+    }
+
+}
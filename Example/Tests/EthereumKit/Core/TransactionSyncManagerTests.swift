@@ -0,0 +1,217 @@
+import XCTest
+import RxSwift
+import Cuckoo
+@testable import EthereumKit
+
+class TransactionSyncManagerTests: XCTestCase {
+    private let userAddress = Address(raw: Data(repeating: 0xab, count: 20))
+    private let hash = Data(repeating: 1, count: 32)
+
+    private var directoryUrl: URL!
+    private var mockBlockchain: MockIBlockchain!
+    private var mockProvider: MockITransactionProvider!
+    private var storage: TransactionStorage!
+    private var transactionManager: TransactionManager!
+    private var pendingTransactionSyncer: PendingTransactionSyncer!
+    private var syncManager: TransactionSyncManager!
+    private var disposeBag: DisposeBag!
+
+    override func setUp() {
+        super.setUp()
+
+        directoryUrl = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString)
+        try! FileManager.default.createDirectory(at: directoryUrl, withIntermediateDirectories: true)
+
+        mockBlockchain = MockIBlockchain()
+        mockProvider = MockITransactionProvider()
+        storage = TransactionStorage(databaseDirectoryUrl: directoryUrl, databaseFileName: "transactions")
+        let syncerStateStorage = TransactionSyncerStateStorage(databaseDirectoryUrl: directoryUrl, databaseFileName: "transaction-syncer-states")
+        let decorationManager = DecorationManager(userAddress: userAddress, storage: storage)
+
+        transactionManager = TransactionManager(userAddress: userAddress, storage: storage, decorationManager: decorationManager, blockchain: mockBlockchain, transactionProvider: mockProvider)
+        pendingTransactionSyncer = PendingTransactionSyncer(blockchain: mockBlockchain, storage: storage, syncerStateStorage: syncerStateStorage)
+        syncManager = TransactionSyncManager(transactionManager: transactionManager)
+        disposeBag = DisposeBag()
+    }
+
+    override func tearDown() {
+        disposeBag = nil
+        syncManager = nil
+        pendingTransactionSyncer = nil
+        transactionManager = nil
+        storage = nil
+        mockProvider = nil
+        mockBlockchain = nil
+        try? FileManager.default.removeItem(at: directoryUrl)
+
+        super.tearDown()
+    }
+
+    private func syncedInitial(syncerInitial: Bool, lastBlockHeight: Int?) -> Bool? {
+        stub(mockBlockchain) { mock in
+            when(mock.lastBlockHeight.get).thenReturn(lastBlockHeight)
+        }
+
+        let transaction = Transaction(hash: hash, timestamp: 1, isFailed: false, blockNumber: 1, from: userAddress)
+
+        syncManager.add(syncer: StubTransactionSyncer(result: ([transaction], syncerInitial)))
+        syncManager.add(syncer: pendingTransactionSyncer)
+
+        let e = expectation(description: "Transactions handled")
+        var initial: Bool?
+
+        transactionManager.fullTransactionsObservable
+                .subscribe(onNext: { _, isInitial in
+                    initial = isInitial
+                    e.fulfill()
+                })
+                .disposed(by: disposeBag)
+
+        syncManager.sync()
+        waitForExpectations(timeout: 2)
+
+        return initial
+    }
+
+    func testInitial_PendingSyncerWithoutLastBlockHeight() {
+        XCTAssertEqual(syncedInitial(syncerInitial: true, lastBlockHeight: nil), true)
+    }
+
+    func testInitial_PendingSyncerWithoutPendingTransactions() {
+        XCTAssertEqual(syncedInitial(syncerInitial: true, lastBlockHeight: 100), true)
+    }
+
+    func testNotInitial_IncrementalSync() {
+        XCTAssertEqual(syncedInitial(syncerInitial: false, lastBlockHeight: 100), false)
+    }
+
+    private func internalTransaction(blockNumber: Int) -> ProviderInternalTransaction {
+        try! ProviderInternalTransaction(JSON: [
+            "hash": "0x" + hash.toHexString(),
+            "blockNumber": String(blockNumber),
+            "timeStamp": "1000",
+            "from": "0x" + String(repeating: "cd", count: 20),
+            "to": userAddress.hex,
+            "value": "1000",
+            "traceId": "0"
+        ])
+    }
+
+    private func syncedFullTransactions() -> [FullTransaction] {
+        let e = expectation(description: "Synced")
+        var fullTransactions = [FullTransaction]()
+
+        transactionManager.fullTransactionsObservable
+                .subscribe(onNext: { transactions, _ in
+                    fullTransactions.append(contentsOf: transactions)
+                })
+                .disposed(by: disposeBag)
+
+        syncManager.stateObservable
+                .filter { $0 == .synced }
+                .take(1)
+                .subscribe(onNext: { _ in e.fulfill() })
+                .disposed(by: disposeBag)
+
+        syncManager.sync()
+        waitForExpectations(timeout: 2)
+
+        return fullTransactions
+    }
+
+    func testCheckpoint_SavedAfterStoreBeforeDecoration() {
+        var emitted = false
+        let syncer = StubCheckpointedTransactionSyncer(result: ([Transaction(hash: hash, timestamp: 1, isFailed: false)], false)) { [unowned self] in
+            (stored: self.storage.transaction(hash: self.hash) != nil, emitted: emitted)
+        }
+
+        transactionManager.fullTransactionsObservable
+                .subscribe(onNext: { _ in emitted = true })
+                .disposed(by: disposeBag)
+
+        syncManager.add(syncer: syncer)
+
+        XCTAssertEqual(syncedFullTransactions().map { $0.transaction.hash }, [hash])
+        XCTAssertEqual(syncer.checkpoints.count, 1)
+        XCTAssertEqual(syncer.checkpoints.first?.stored, true)
+        XCTAssertEqual(syncer.checkpoints.first?.emitted, false)
+    }
+
+    func testInternalTransactions_SavedOnlyOnCheckpoint() {
+        stub(mockProvider) { mock in
+            when(mock.internalTransactionsSingle(startBlock: any())).thenReturn(Single.just([internalTransaction(blockNumber: 100)]))
+        }
+
+        let syncer = InternalTransactionSyncer(provider: mockProvider, storage: storage)
+        let e = expectation(description: "Transactions synced")
+
+        syncer.transactionsSingle()
+                .subscribe(onSuccess: { _ in e.fulfill() })
+                .disposed(by: disposeBag)
+
+        waitForExpectations(timeout: 2)
+
+        XCTAssertTrue(storage.internalTransactions().isEmpty)
+
+        syncer.saveCheckpoint()
+
+        XCTAssertEqual(storage.lastInternalTransaction()?.blockNumber, 100)
+    }
+
+    func testInternalTransactions_DecoratedInSyncedBatch() {
+        stub(mockProvider) { mock in
+            when(mock.internalTransactionsSingle(startBlock: any())).thenReturn(Single.just([internalTransaction(blockNumber: 100)]))
+        }
+
+        syncManager.add(syncer: InternalTransactionSyncer(provider: mockProvider, storage: storage))
+
+        let decoration = syncedFullTransactions().first?.decoration as? UnknownTransactionDecoration
+
+        XCTAssertEqual(decoration?.internalTransactions.map { $0.hash }, [hash])
+        XCTAssertEqual(storage.lastInternalTransaction()?.blockNumber, 100)
+    }
+
+    func testInternalTransactions_NotSavedOnError() {
+        stub(mockProvider) { mock in
+            when(mock.internalTransactionsSingle(startBlock: any())).thenReturn(Single.error(Kit.KitError.weakReference))
+        }
+
+        syncManager.add(syncer: InternalTransactionSyncer(provider: mockProvider, storage: storage))
+
+        XCTAssertTrue(syncedFullTransactions().isEmpty)
+        XCTAssertNil(storage.lastInternalTransaction())
+    }
+
+}
+
+extension TransactionSyncManagerTests {
+
+    private class StubTransactionSyncer: ITransactionSyncer {
+        private let result: ([Transaction], Bool)
+
+        init(result: ([Transaction], Bool)) {
+            self.result = result
+        }
+
+        func transactionsSingle() -> Single<([Transaction], Bool)> {
+            Single.just(result)
+        }
+    }
+
+    private class StubCheckpointedTransactionSyncer: StubTransactionSyncer, ICheckpointedTransactionSyncer {
+        private let state: () -> (stored: Bool, emitted: Bool)
+
+        var checkpoints = [(stored: Bool, emitted: Bool)]()
+
+        init(result: ([Transaction], Bool), state: @escaping () -> (stored: Bool, emitted: Bool)) {
+            self.state = state
+
+            super.init(result: result)
+        }
+
+        func saveCheckpoint() {
+            checkpoints.append(state())
+        }
+    }
+
+}
@@ -110,7 +110,7 @@ extension BlockHeader: Equatable {
         self.init(
                 hashHex: hashHex,
                 totalDifficulty: totalDifficulty,
-                parentHash: Data(),
+                parentHash: parentHash,
                 unclesHash: Data(),
                 coinbase: Data(),
                 stateRoot: Data(),
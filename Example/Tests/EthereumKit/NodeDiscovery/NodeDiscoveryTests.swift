@@ -21,10 +21,17 @@ class NodeDiscoveryTests: QuickSpec {
         let node = Node(id: Data(repeating: 2, count: 64), host: "host", port: 1, discoveryPort: 2)
         let nodeRecord = NodeRecord(id: Data(repeating: 2, count: 64), host: "host", port: 1, discoveryPort: 2, used: false, eligible: false, score: 1, timestamp: 10)
 
-        let state = NodeDiscoveryState()
-        let discovery = NodeDiscovery(ecKey: ecKey, factory: mockFactory, discoveryStorage: mockDiscoveryStorage, state: state, nodeParser: mockNodeParser, packetParser: mockPacketParser)
+        var state = NodeDiscoveryState()
+        var discovery = NodeDiscovery(ecKey: ecKey, factory: mockFactory, discoveryStorage: mockDiscoveryStorage, state: state, nodeParser: mockNodeParser, packetParser: mockPacketParser)
         discovery.nodeManager = mockManager
 
+        // the node table and queried nodes are kept by the discovery, so each example starts with a new one
+        beforeEach {
+            state = NodeDiscoveryState()
+            discovery = NodeDiscovery(ecKey: ecKey, factory: mockFactory, discoveryStorage: mockDiscoveryStorage, state: state, nodeParser: mockNodeParser, packetParser: mockPacketParser)
+            discovery.nodeManager = mockManager
+        }
+
         afterEach {
             reset(mockDiscoveryStorage, mockClient, mockFactory, mockNodeParser, mockPacketParser, mockManager)
         }
@@ -33,7 +40,7 @@ class NodeDiscoveryTests: QuickSpec {
             context("get node from storage") {
                 it("throws error when first time return nil") {
                     stub(mockDiscoveryStorage) { mock in
-                        when(mock.nonUsedNode()).thenReturn(nil)
+                        when(mock.nonUsedNodes()).thenReturn([])
                     }
                     do {
                         try discovery.lookup()
@@ -43,13 +50,13 @@ class NodeDiscoveryTests: QuickSpec {
                         XCTFail("Unexpected error!")
                     }
 
-                    verify(mockDiscoveryStorage).nonUsedNode()
+                    verify(mockDiscoveryStorage).nonUsedNodes()
                     verifyNoMoreInteractions(mockDiscoveryStorage)
                 }
                 context("make node used and start find neighbors") {
                     beforeEach {
                         stub(mockDiscoveryStorage) { mock in
-                            when(mock.nonUsedNode()).thenReturn(nodeRecord)
+                            when(mock.nonUsedNodes()).thenReturn([nodeRecord])
                             when(mock.setUsed(node: equal(to: nodeRecord))).thenDoNothing()
                         }
                     }
@@ -64,7 +71,7 @@ class NodeDiscoveryTests: QuickSpec {
                         } catch {
                             XCTFail("Unexpected error!")
                         }
-                        verify(mockDiscoveryStorage).nonUsedNode()
+                        verify(mockDiscoveryStorage).nonUsedNodes()
                         verify(mockDiscoveryStorage).setUsed(node: equal(to: nodeRecord))
                         verify(mockFactory).client(node: equal(to: node), timeoutInterval: NodeDiscovery.timeoutInterval)
                         verifyNoMoreInteractions(mockDiscoveryStorage)
@@ -152,23 +159,28 @@ class NodeDiscoveryTests: QuickSpec {
                                         when(mock.send(equal(to: findNodeData))).thenDoNothing()
                                     }
                                 }
-                                it("sends findNodeData and goes to second iteration with error AllNodesUsed") {
+                                beforeEach {
+                                    state.removeAll()
+                                }
+                                it("sends findNodeData once to each not used node") {
                                     stub(mockDiscoveryStorage) { mock in
-                                        when(mock.nonUsedNode()).thenReturn(nodeRecord).thenReturn(nil)
+                                        when(mock.nonUsedNodes()).thenReturn([nodeRecord])
                                     }
 
                                     do {
                                         try discovery.lookup()
-                                    } catch let error as DiscoveryError {
-                                        XCTAssertEqual(error, DiscoveryError.allNodesUsed)
                                     } catch {
                                         XCTFail("Unexpected error!")
                                     }
-                                    verify(mockClient).send(equal(to: findNodeData))
+                                    verify(mockClient, times(1)).send(equal(to: findNodeData))
                                 }
-                                it("success get nodes and send to all alpha-count nodes") {
+                                it("does not send findNodeData when alpha-count requests are in flight") {
                                     stub(mockDiscoveryStorage) { mock in
-                                        when(mock.nonUsedNode()).thenReturn(nodeRecord)
+                                        when(mock.nonUsedNodes()).thenReturn([nodeRecord])
+                                    }
+
+                                    for _ in 0..<NodeDiscovery.alpha {
+                                        state.add(client: mockClient)
                                     }
 
                                     do {
@@ -176,7 +188,7 @@ class NodeDiscoveryTests: QuickSpec {
                                     } catch {
                                         XCTFail("Unexpected error!")
                                     }
-                                    verify(mockClient, times(NodeDiscovery.alpha)).send(equal(to: findNodeData))
+                                    verify(mockClient, never()).send(equal(to: findNodeData))
                                 }
                             }
                         }
@@ -220,6 +232,12 @@ class NodeDiscoveryTests: QuickSpec {
             let hash = Data(repeating: 3, count: 2)
             let sig = Data(repeating: 4, count: 2)
 
+            beforeEach {
+                stub(mockClient) { mock in
+                    when(mock.node.get).thenReturn(node)
+                }
+            }
+
             context("receive any wrong packet") {
                 stub(mockPacketParser) { mock in
                     when(mock.parse(data: equal(to: data))).thenThrow(PacketParseError.tooSmall)
@@ -328,7 +346,7 @@ class NodeDiscoveryTests: QuickSpec {
                         }
                         it("sends findNodeData") {
                             stub(mockDiscoveryStorage) { mock in
-                                when(mock.nonUsedNode()).thenReturn(nodeRecord).thenReturn(nil)
+                                when(mock.nonUsedNodes()).thenReturn([nodeRecord])
                             }
 
                             do {
@@ -341,7 +359,7 @@ class NodeDiscoveryTests: QuickSpec {
                         }
                         it("success get nodes") {
                             stub(mockDiscoveryStorage) { mock in
-                                when(mock.nonUsedNode()).thenReturn(nodeRecord)
+                                when(mock.nonUsedNodes()).thenReturn([nodeRecord])
                             }
 
                             do {
@@ -362,6 +380,13 @@ class NodeDiscoveryTests: QuickSpec {
                     stub(mockPacketParser) { mock in
                         when(mock.parse(data: equal(to: data))).thenReturn(packet)
                     }
+                    stub(mockDiscoveryStorage) { mock in
+                        when(mock.contain(nodeId: equal(to: expectedNode.id))).thenReturn(false)
+                        when(mock.nonUsedNodes()).thenReturn([])
+                    }
+                    stub(mockFactory) { mock in
+                        when(mock.client(node: any(), timeoutInterval: any())).thenThrow(UDPClientError.cantCreateAddress)
+                    }
                 }
                 it("calls nodeManager add nodes") {
                     stub(mockManager) { mock in
@@ -375,6 +400,127 @@ class NodeDiscoveryTests: QuickSpec {
                     }
                     verify(mockManager).add(nodes: equal(to: [expectedNode]))
                 }
+                it("queries received node from the table") {
+                    stub(mockManager) { mock in
+                        when(mock.add(nodes: any())).thenDoNothing()
+                    }
+
+                    do {
+                        try discovery.didReceive(mockClient, data: data)
+                    } catch {
+                        XCTFail("Unexpected error!")
+                    }
+                    verify(mockFactory).client(node: equal(to: expectedNode), timeoutInterval: NodeDiscovery.timeoutInterval)
+                }
+            }
+        }
+        describe("liveness of the oldest node of a full bucket") {
+            let data = Data([0x04])
+            let pingData = Data(repeating: 9, count: 2)
+            let mockPingClient = MockIUdpClient()
+
+            // ids falling into the farthest bucket, one more than the bucket holds
+            let selfHash = CryptoUtils.shared.sha3(nodeId)
+            let bucketNodes = (2...255)
+                    .map { Data(repeating: UInt8($0), count: 64) }
+                    .filter { NodeTable.logDistance(CryptoUtils.shared.sha3($0), selfHash) == NodeTable.hashBits }
+                    .prefix(NodeTable.bucketSize + 1)
+                    .map { Node(id: $0, host: "host", port: 1, discoveryPort: 2) }
+            let oldest = bucketNodes[0]
+            let replacement = bucketNodes[NodeTable.bucketSize]
+
+            let packet = Packet(hash: Data(), signature: Data(), type: 4, package: NeighborsPackage(nodes: bucketNodes, expiration: Int32(NodeDiscovery.expirationInterval)))
+
+            let receiveNeighbors = {
+                do {
+                    try discovery.didReceive(mockClient, data: data)
+                } catch {
+                    XCTFail("Unexpected error!")
+                }
+            }
+
+            beforeEach {
+                stub(mockPacketParser) { mock in
+                    when(mock.parse(data: equal(to: data))).thenReturn(packet)
+                }
+                stub(mockClient) { mock in
+                    when(mock.node.get).thenReturn(node)
+                }
+                stub(mockDiscoveryStorage) { mock in
+                    when(mock.contain(nodeId: any())).thenReturn(false)
+                    when(mock.nonUsedNodes()).thenReturn([])
+                    when(mock.remove(node: any())).thenDoNothing()
+                }
+                stub(mockManager) { mock in
+                    when(mock.add(nodes: any())).thenDoNothing()
+                }
+                stub(mockFactory) { mock in
+                    when(mock.client(node: any(), timeoutInterval: NodeDiscovery.timeoutInterval)).thenThrow(UDPClientError.cantCreateAddress)
+                    when(mock.client(node: equal(to: oldest), timeoutInterval: NodeDiscovery.pingTimeoutInterval)).thenReturn(mockPingClient)
+                    when(mock.pingData(from: equal(to: selfNode), to: equal(to: oldest), expiration: NodeDiscovery.expirationInterval)).thenReturn(pingData)
+                }
+                stub(mockPingClient) { mock in
+                    when(mock.node.get).thenReturn(oldest)
+                    when(mock.id.get).thenReturn(oldest.id)
+                    when(mock.noResponse.get).thenReturn(true)
+                    when(mock.delegate.set(any())).thenDoNothing()
+                    when(mock.listen()).thenDoNothing()
+                    when(mock.send(equal(to: pingData))).thenDoNothing()
+                }
+            }
+            afterEach {
+                reset(mockPingClient)
+            }
+
+            it("pings the oldest node with the ping timeout") {
+                receiveNeighbors()
+
+                verify(mockFactory).client(node: equal(to: oldest), timeoutInterval: NodeDiscovery.pingTimeoutInterval)
+                verify(mockPingClient).listen()
+                verify(mockPingClient).send(equal(to: pingData))
+            }
+            it("does not ping the oldest node again while the ping is in flight") {
+                receiveNeighbors()
+                receiveNeighbors()
+
+                verify(mockFactory, times(1)).client(node: equal(to: oldest), timeoutInterval: NodeDiscovery.pingTimeoutInterval)
+            }
+            it("pings the oldest node again when the client could not be created") {
+                stub(mockFactory) { mock in
+                    when(mock.client(node: equal(to: oldest), timeoutInterval: NodeDiscovery.pingTimeoutInterval)).thenThrow(UDPClientError.cantCreateAddress)
+                }
+                receiveNeighbors()
+
+                stub(mockFactory) { mock in
+                    when(mock.client(node: equal(to: oldest), timeoutInterval: NodeDiscovery.pingTimeoutInterval)).thenReturn(mockPingClient)
+                }
+                receiveNeighbors()
+
+                verify(mockFactory, times(2)).client(node: equal(to: oldest), timeoutInterval: NodeDiscovery.pingTimeoutInterval)
+                verify(mockPingClient).send(equal(to: pingData))
+            }
+            it("replaces the oldest node when it does not answer") {
+                receiveNeighbors()
+                discovery.didStop(mockPingClient, by: TestError())
+
+                verify(mockDiscoveryStorage).remove(node: equal(to: oldest))
+                verify(mockManager).add(nodes: equal(to: [replacement]))
+            }
+            it("keeps the oldest node when it answers") {
+                stub(mockPingClient) { mock in
+                    when(mock.noResponse.get).thenReturn(false)
+                }
+
+                receiveNeighbors()
+                discovery.didStop(mockPingClient, by: TestError())
+
+                verify(mockDiscoveryStorage, never()).remove(node: equal(to: oldest))
+                verify(mockManager, never()).add(nodes: equal(to: [replacement]))
+
+                // the ping is finished, so the next full bucket pings the oldest node again
+                receiveNeighbors()
+
+                verify(mockFactory, times(2)).client(node: equal(to: oldest), timeoutInterval: NodeDiscovery.pingTimeoutInterval)
             }
         }
     }
@@ -0,0 +1,137 @@
+import XCTest
+import Quick
+import Nimble
+@testable import EthereumKit
+
+class NodeTableTests: QuickSpec {
+
+    override func spec() {
+        let selfId = Data(repeating: 1, count: 64)
+
+        describe("#logDistance") {
+            it("returns 0 for equal hashes") {
+                let hash = Data(repeating: 0xab, count: 32)
+                expect(NodeTable.logDistance(hash, hash)).to(equal(0))
+            }
+            it("returns position of the first different bit") {
+                let hash = Data(repeating: 0, count: 32)
+                var other = hash
+                other[31] = 0x01
+                expect(NodeTable.logDistance(hash, other)).to(equal(1))
+
+                other[0] = 0x80
+                expect(NodeTable.logDistance(hash, other)).to(equal(256))
+            }
+        }
+
+        let selfHash = CryptoUtils.shared.sha3(selfId)
+        let node: (Data) -> Node = { Node(id: $0, host: "host", port: 1, discoveryPort: 2) }
+
+        // ids falling into the same bucket, the farthest one holds about a half of all ids
+        let sameBucketIds = (2...64)
+                .map { Data(repeating: UInt8($0), count: 64) }
+                .filter { NodeTable.logDistance(CryptoUtils.shared.sha3($0), selfHash) == NodeTable.hashBits }
+
+        describe("#add") {
+            it("does not add nodes to a full bucket") {
+                let table = NodeTable(selfId: selfId, bucketSize: 1)
+                let ids = (2...64).map { Data(repeating: UInt8($0), count: 64) }
+
+                let added = ids.filter {
+                    if case .added = table.add(node: node($0)) {
+                        return true
+                    }
+                    return false
+                }
+
+                expect(table.count).to(equal(added.count))
+                expect(added.count).to(beLessThan(ids.count))
+            }
+            it("keeps already added nodes") {
+                let table = NodeTable(selfId: selfId)
+                let id = Data(repeating: 2, count: 64)
+
+                guard case .added = table.add(node: node(id)), case .exists = table.add(node: node(id)) else {
+                    return XCTFail("Unexpected add result")
+                }
+                expect(table.count).to(equal(1))
+
+                table.remove(id: id)
+                expect(table.count).to(equal(0))
+            }
+            it("returns the least recently seen node of a full bucket") {
+                let table = NodeTable(selfId: selfId, bucketSize: 2)
+
+                table.add(node: node(sameBucketIds[0]))
+                table.add(node: node(sameBucketIds[1]))
+
+                guard case .bucketFull(let oldest) = table.add(node: node(sameBucketIds[2])) else {
+                    return XCTFail("Unexpected add result")
+                }
+                expect(oldest.id).to(equal(sameBucketIds[0]))
+
+                table.touch(id: sameBucketIds[0])
+
+                guard case .bucketFull(let nextOldest) = table.add(node: node(sameBucketIds[3])) else {
+                    return XCTFail("Unexpected add result")
+                }
+                expect(nextOldest.id).to(equal(sameBucketIds[1]))
+                expect(table.count).to(equal(2))
+            }
+        }
+
+        describe("#remove") {
+            it("replaces removed node with the most recent replacement") {
+                let table = NodeTable(selfId: selfId, bucketSize: 2)
+
+                for id in sameBucketIds.prefix(4) {
+                    table.add(node: node(id))
+                }
+
+                expect(table.remove(id: sameBucketIds[0])?.id).to(equal(sameBucketIds[3]))
+                expect(table.remove(id: sameBucketIds[1])?.id).to(equal(sameBucketIds[2]))
+                expect(table.remove(id: sameBucketIds[2])).to(beNil())
+                expect(table.count).to(equal(1))
+            }
+        }
+
+        describe("#closest") {
+            let ids = (2...64).map { Data(repeating: UInt8($0), count: 64) }
+            let distance: (Data) -> Data = { NodeTable.distance(CryptoUtils.shared.sha3($0), selfHash) }
+
+            it("returns nodes of the buckets closest to self node first") {
+                let table = NodeTable(selfId: selfId, bucketSize: ids.count)
+
+                for id in ids {
+                    table.add(node: node(id))
+                }
+
+                let expected = ids.sorted { distance($0).lexicographicallyPrecedes(distance($1)) }.prefix(3)
+
+                expect(table.closest(count: 3).map { $0.id }).to(equal(Array(expected)))
+            }
+            it("skips excluded nodes") {
+                let table = NodeTable(selfId: selfId, bucketSize: ids.count)
+
+                for id in ids {
+                    table.add(node: node(id))
+                }
+
+                let closest = table.closest(count: 2).map { $0.id }
+                let next = table.closest(count: 2, excludingIds: Set(closest)).map { $0.id }
+
+                expect(Set(next).isDisjoint(with: closest)).to(beTrue())
+                expect(table.closest(count: 4).map { $0.id }).to(equal(closest + next))
+            }
+            it("does not return replacements") {
+                let table = NodeTable(selfId: selfId, bucketSize: 1)
+
+                table.add(node: node(sameBucketIds[0]))
+                table.add(node: node(sameBucketIds[1]))
+
+                expect(table.closest(count: 10).map { $0.id }.contains(sameBucketIds[1])).to(beFalse())
+            }
+        }
+    }
+
+}
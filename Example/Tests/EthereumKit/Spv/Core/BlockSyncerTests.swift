@@ -0,0 +1,250 @@
+import XCTest
+import Cuckoo
+@testable import EthereumKit
+
+class BlockSyncerTests: XCTestCase {
+    private let headersLimit = 5
+    private let bestBlockHeight = 20
+
+    private var mockStorage: MockISpvStorage!
+    private var mockBlockHelper: MockIBlockHelper!
+    private var peer: StubPeer!
+    private var delegate: StubBlockSyncerDelegate!
+    private var syncer: BlockSyncer!
+
+    private var savedBlockHeaders = [[BlockHeader]]()
+
+    override func setUp() {
+        super.setUp()
+
+        mockStorage = MockISpvStorage()
+        mockBlockHelper = MockIBlockHelper()
+        peer = StubPeer()
+        delegate = StubBlockSyncerDelegate()
+        savedBlockHeaders = []
+
+        stub(mockStorage) { mock in
+            when(mock.save(blockHeaders: any())).then { [unowned self] blockHeaders in
+                self.savedBlockHeaders.append(blockHeaders)
+            }
+        }
+        stub(mockBlockHelper) { mock in
+            when(mock.lastBlockHeader.get).thenReturn(header(height: 0))
+        }
+
+        syncer = BlockSyncer(storage: mockStorage, blockHelper: mockBlockHelper, validator: BlockValidator(), headersLimit: headersLimit, windowSize: 3)
+        syncer.delegate = delegate
+    }
+
+    override func tearDown() {
+        syncer = nil
+        delegate = nil
+        peer = nil
+        mockBlockHelper = nil
+        mockStorage = nil
+
+        super.tearDown()
+    }
+
+    // headers of a forked chain differ from the main chain starting at `forkHeight`
+    private func hash(height: Int, forkHeight: Int? = nil) -> Data {
+        let forked: UInt8 = forkHeight.map { height >= $0 ? 1 : 0 } ?? 0
+        return Data([forked]) + withUnsafeBytes(of: Int64(height).bigEndian) { Data($0) }
+    }
+
+    private func header(height: Int, forkHeight: Int? = nil) -> BlockHeader {
+        BlockHeader(hashHex: hash(height: height, forkHeight: forkHeight), parentHash: hash(height: height - 1, forkHeight: forkHeight), height: height)
+    }
+
+    private func headers(from: Int, count: Int, forkHeight: Int? = nil) -> [BlockHeader] {
+        (from..<(from + count)).map { header(height: $0, forkHeight: forkHeight) }
+    }
+
+    private func handshake(flowControl: FlowControl = FlowControl(bufferLimit: 0, rechargeRate: 0, maxCosts: [])) {
+        syncer.didCompleteHandshake(peer: peer, bestBlockHash: hash(height: bestBlockHeight), bestBlockHeight: bestBlockHeight, flowControl: flowControl)
+    }
+
+    private func respond(height: Int, blockHeaders: [BlockHeader], reverse: Bool = false, bufferValue: Int = 0) {
+        syncer.didReceive(peer: peer, blockHeaders: blockHeaders, height: height, reverse: reverse, bufferValue: bufferValue)
+    }
+
+    private func flowControl(bufferLimit: Int) -> FlowControl {
+        let maxCost = MaxCost(messageCode: 0x02, baseCost: 0, requestCost: 10)
+        return FlowControl(bufferLimit: bufferLimit, rechargeRate: 0, maxCosts: [maxCost], currentTime: { 0 })
+    }
+
+    func testWindow_RequestsRangesAhead() {
+        handshake()
+
+        XCTAssertEqual(peer.tasks.map { $0.height }, [0, 4, 8])
+        XCTAssertEqual(peer.tasks.map { $0.limit }, [5, 5, 5])
+        XCTAssertFalse(peer.tasks.contains { $0.reverse })
+    }
+
+    func testWindow_NextRangeRequestedOnResponse() {
+        handshake()
+        respond(height: 0, blockHeaders: headers(from: 0, count: 5))
+
+        XCTAssertEqual(peer.tasks.map { $0.height }, [0, 4, 8, 12])
+        XCTAssertEqual(savedBlockHeaders, [headers(from: 0, count: 5)])
+        XCTAssertEqual(delegate.updatedBlockHeaders.last, header(height: 4))
+    }
+
+    func testWindow_OutOfOrderRangesValidatedInOrder() {
+        handshake()
+
+        respond(height: 8, blockHeaders: headers(from: 8, count: 5))
+        respond(height: 4, blockHeaders: headers(from: 4, count: 5))
+
+        XCTAssertTrue(savedBlockHeaders.isEmpty)
+
+        respond(height: 0, blockHeaders: headers(from: 0, count: 5))
+
+        XCTAssertEqual(savedBlockHeaders, [headers(from: 0, count: 5), headers(from: 4, count: 5), headers(from: 8, count: 5)])
+        XCTAssertEqual(delegate.updatedBlockHeaders.last, header(height: 12))
+        XCTAssertTrue(delegate.errors.isEmpty)
+    }
+
+    func testWindow_FinishesOnShortRange() {
+        handshake()
+
+        respond(height: 0, blockHeaders: headers(from: 0, count: 5))
+        respond(height: 4, blockHeaders: headers(from: 4, count: 3))
+
+        XCTAssertEqual(delegate.successBlockHeaders, [header(height: 6)])
+
+        // pipeline is stopped, responses to the remaining ranges are ignored
+        respond(height: 8, blockHeaders: headers(from: 8, count: 5))
+
+        XCTAssertEqual(savedBlockHeaders.count, 2)
+    }
+
+    func testEmptyResponse_FinishesSync() {
+        handshake()
+        respond(height: 0, blockHeaders: [])
+
+        XCTAssertEqual(delegate.successBlockHeaders, [header(height: 0)])
+        XCTAssertTrue(savedBlockHeaders.isEmpty)
+
+        // sync is not stuck: a new announcement starts a new pipeline
+        syncer.didAnnounce(peer: peer, blockHash: hash(height: bestBlockHeight), blockHeight: bestBlockHeight)
+
+        XCTAssertEqual(peer.tasks.map { $0.height }, [0, 4, 8, 0, 4, 8])
+    }
+
+    func testEmptyResponse_AfterValidatedRanges() {
+        handshake()
+
+        respond(height: 4, blockHeaders: [])
+        respond(height: 0, blockHeaders: headers(from: 0, count: 5))
+
+        XCTAssertEqual(savedBlockHeaders, [headers(from: 0, count: 5)])
+        XCTAssertEqual(delegate.successBlockHeaders, [header(height: 4)])
+    }
+
+    func testFork_AtWindowBoundary() {
+        stub(mockStorage) { mock in
+            when(mock.reversedLastBlockHeaders(from: 4, limit: any())).thenReturn(Array(headers(from: 0, count: 5).reversed()))
+        }
+
+        handshake()
+
+        respond(height: 0, blockHeaders: headers(from: 0, count: 5))
+        // the peer switched to a chain forked at the first header of the second range
+        respond(height: 4, blockHeaders: headers(from: 4, count: 5, forkHeight: 4))
+
+        XCTAssertEqual(peer.tasks.last?.height, 4)
+        XCTAssertEqual(peer.tasks.last?.reverse, true)
+        XCTAssertEqual(savedBlockHeaders.count, 1)
+
+        // response to a range of the stopped pipeline
+        respond(height: 8, blockHeaders: headers(from: 8, count: 5, forkHeight: 4))
+
+        XCTAssertEqual(savedBlockHeaders.count, 1)
+
+        respond(height: 4, blockHeaders: Array(headers(from: 0, count: 5, forkHeight: 4).reversed()), reverse: true)
+
+        // the pipeline restarts from the last common header
+        XCTAssertEqual(peer.tasks.suffix(3).map { $0.height }, [3, 7, 11])
+
+        respond(height: 3, blockHeaders: headers(from: 3, count: 5, forkHeight: 4))
+
+        XCTAssertEqual(savedBlockHeaders.last, headers(from: 3, count: 5, forkHeight: 4))
+        XCTAssertTrue(delegate.errors.isEmpty)
+    }
+
+    func testFlowControl_WindowLimitedByBuffer() {
+        // each request costs 10 * 5 headers, the buffer fits two of them
+        handshake(flowControl: flowControl(bufferLimit: 100))
+
+        XCTAssertEqual(peer.tasks.map { $0.height }, [0, 4])
+    }
+
+    func testFlowControl_FirstRangeAlwaysRequested() {
+        handshake(flowControl: flowControl(bufferLimit: 0))
+
+        XCTAssertEqual(peer.tasks.map { $0.height }, [0])
+    }
+
+    func testFlowControl_WindowGrowsWithBufferValue() {
+        handshake(flowControl: flowControl(bufferLimit: 100))
+
+        // the reply reports a full buffer, one range is still in flight
+        respond(height: 0, blockHeaders: headers(from: 0, count: 5), bufferValue: 100)
+
+        XCTAssertEqual(peer.tasks.map { $0.height }, [0, 4, 8])
+    }
+
+    func testFlowControl_WindowShrinksWithBufferValue() {
+        handshake(flowControl: flowControl(bufferLimit: 100))
+
+        respond(height: 0, blockHeaders: headers(from: 0, count: 5), bufferValue: 60)
+
+        XCTAssertEqual(peer.tasks.map { $0.height }, [0, 4])
+    }
+
+}
+
+extension BlockSyncerTests {
+
+    private class StubPeer: IPeer {
+        let id = "peer"
+        weak var delegate: IPeerDelegate?
+
+        var tasks = [BlockHeadersTask]()
+
+        func register(messageHandler: IMessageHandler) {
+        }
+
+        func connect() {
+        }
+
+        func register(taskHandler: ITaskHandler) {
+        }
+
+        func add(task: ITask) {
+            if let task = task as? BlockHeadersTask {
+                tasks.append(task)
+            }
+        }
+    }
+
+    private class StubBlockSyncerDelegate: IBlockSyncerDelegate {
+        var successBlockHeaders = [BlockHeader]()
+        var updatedBlockHeaders = [BlockHeader]()
+        var errors = [Error]()
+
+        func onSuccess(taskPerformer: ITaskPerformer, lastBlockHeader: BlockHeader) {
+            successBlockHeaders.append(lastBlockHeader)
+        }
+
+        func onFailure(error: Error) {
+            errors.append(error)
+        }
+
+        func onUpdate(lastBlockHeader: BlockHeader) {
+            updatedBlockHeaders.append(lastBlockHeader)
+        }
+    }
+
+}
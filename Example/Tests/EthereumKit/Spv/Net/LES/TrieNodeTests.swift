@@ -0,0 +1,80 @@
+import XCTest
+import BigInt
+@testable import EthereumKit
+
+class TrieNodeTests: XCTestCase {
+    // sha3 of the address is 7ca0f39e5365e0346f7ac4c86d86e646721a9cf10f4d15dfe8a7f4d636013d60
+    private let address = try! Address(hex: "0xb1d4a5d46f3c3c2c0f5a2c4e8d3f6d4a6c3e5f21")
+
+    // PROOFS messages of the same account (nonce 5, balance 1 ETH) in two state tries: extension -> branch -> leaf
+
+    // extension with the odd path [7], branch at nibble c, leaf with the even 62-nibble remainder
+    private let oddExtensionStateRoot = Data(hex: "39109548bc4dbf6afb6f580d3ef9950968fa39e216d5a831d0d88f3e35336232")!
+    private let oddExtensionProofs = Data(hex: "f9017107830493e0f90169e217a0c8a91b21c1a78297b8a8f7098d71dbfd3b10b6c6d6acc6ca989e9668411a2240f8d1a0d8cdc310411e7ec27378a661c935187c07e4d5636e9bc3c400b27244b8cd3a978080a006a68a02f0e161af37f86cb9078738c370f07e8d3b583bad38c275f34aed056a808080a0feb9dc4b1ebe55e5b8f9b680eff76c81d4e9ab304d4896f9e17fd8f0816496daa03ebecc676aaa2c5d8ce1b3c6acbc5f1670a9821bc72985d7645e7dbb07780b4e808080a0fba23f3041d95f9da8ac024877d11d30276c13b42f8ba09a51f7b7334c796246a0803afb03c5338aebdc8c3b678358f3d8935a75e844a88c9bf5ba0162c8dbd2f4808080f871a020a0f39e5365e0346f7ac4c86d86e646721a9cf10f4d15dfe8a7f4d636013d60b84ef84c05880de0b6b3a7640000a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a0c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470")!
+
+    // extension with the even path [7, c], branch at nibble a, leaf with the odd 61-nibble remainder
+    private let evenExtensionStateRoot = Data(hex: "59851337b565a6253e9c2447edbe90fe9c48336c1aba3592702e4111a05e6f8e")!
+    private let evenExtensionProofs = Data(hex: "f9013207830493e0f9012ae482007ca08f2755360f91444c368d1e543d97a92aeb661fd44f60f860bdebcbd38a5eddd6f89180808080a0de5d918d33f081697cd05b6a5800898a9fc99c54759907cd3aa22d8c952edc178080808080a0c64405d394b37071892b3f90e52d374a5e5688627227f174bde4ca65ad2a4dfca0047303c1c1473f441ccc9f2f584a112a284187f32ba845a5b64b74b3527f791da062576bcb30421b40e6ba82fa35f79b6ed1f9053904652509b8f52972b481ad6d80808080f8709f30f39e5365e0346f7ac4c86d86e646721a9cf10f4d15dfe8a7f4d636013d60b84ef84c05880de0b6b3a7640000a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a0c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470")!
+
+    private func assertAccountState(_ accountState: AccountStateSpv, file: StaticString = #file, line: UInt = #line) {
+        XCTAssertEqual(accountState.address, address, file: file, line: line)
+        XCTAssertEqual(accountState.nonce, 5, file: file, line: line)
+        XCTAssertEqual(accountState.balance, BigUInt(1_000_000_000_000_000_000), file: file, line: line)
+        XCTAssertEqual(accountState.storageHash, Data(hex: "56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421")!, file: file, line: line)
+        XCTAssertEqual(accountState.codeHash, Data(hex: "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470")!, file: file, line: line)
+    }
+
+    func testOddExtension_EvenLeaf() throws {
+        let nodes = try ProofsMessage(data: oddExtensionProofs).nodes
+
+        XCTAssertEqual(nodes.map { $0.nodeType }, [.EXTENSION, .BRANCH, .LEAF])
+        XCTAssertEqual(nodes[0].getPath(element: nodes[1].hash), [0x7])
+        XCTAssertEqual(nodes[1].getPath(element: nodes[2].hash), [0xc])
+        XCTAssertEqual(nodes[2].getPath(element: nil)?.count, 62)
+
+        assertAccountState(try TrieNode.accountState(proofNodes: nodes, address: address, stateRoot: oddExtensionStateRoot))
+    }
+
+    func testEvenExtension_OddLeaf() throws {
+        let nodes = try ProofsMessage(data: evenExtensionProofs).nodes
+
+        XCTAssertEqual(nodes.map { $0.nodeType }, [.EXTENSION, .BRANCH, .LEAF])
+        XCTAssertEqual(nodes[0].getPath(element: nodes[1].hash), [0x7, 0xc])
+        XCTAssertEqual(nodes[1].getPath(element: nodes[2].hash), [0xa])
+        XCTAssertEqual(nodes[2].getPath(element: nil)?.count, 61)
+
+        assertAccountState(try TrieNode.accountState(proofNodes: nodes, address: address, stateRoot: evenExtensionStateRoot))
+    }
+
+    func testOtherAddress() throws {
+        let nodes = try ProofsMessage(data: oddExtensionProofs).nodes
+        let otherAddress = Address(raw: Data(repeating: 0x11, count: 20))
+
+        XCTAssertThrowsError(try TrieNode.accountState(proofNodes: nodes, address: otherAddress, stateRoot: oddExtensionStateRoot)) { error in
+            XCTAssertEqual(error as? TrieNode.ProofError, .pathDoesNotMatchAddressHash)
+        }
+    }
+
+    func testOtherStateRoot() throws {
+        let nodes = try ProofsMessage(data: oddExtensionProofs).nodes
+
+        XCTAssertThrowsError(try TrieNode.accountState(proofNodes: nodes, address: address, stateRoot: evenExtensionStateRoot)) { error in
+            XCTAssertEqual(error as? TrieNode.ProofError, .rootHashDoesNotMatchStateRoot)
+        }
+    }
+
+    func testMissingNode() throws {
+        let nodes = try ProofsMessage(data: evenExtensionProofs).nodes
+
+        XCTAssertThrowsError(try TrieNode.accountState(proofNodes: [nodes[0], nodes[2]], address: address, stateRoot: evenExtensionStateRoot)) { error in
+            XCTAssertEqual(error as? TrieNode.ProofError, .nodesNotInterconnected)
+        }
+    }
+
+    func testNoNodes() {
+        XCTAssertThrowsError(try TrieNode.accountState(proofNodes: [], address: address, stateRoot: oddExtensionStateRoot)) { error in
+            XCTAssertEqual(error as? TrieNode.ProofError, .noNodes)
+        }
+    }
+
+}
@@ -0,0 +1,75 @@
+import XCTest
+import BigInt
+import EthereumKit
+@testable import UniswapKit
+
+class TradeManagerTests: XCTestCase {
+    private let tokenA = Token.erc20(address: Address(raw: Data(repeating: 0x0a, count: 20)), decimals: 18)
+    private let tokenB = Token.erc20(address: Address(raw: Data(repeating: 0x0b, count: 20)), decimals: 18)
+    private let tokenC = Token.erc20(address: Address(raw: Data(repeating: 0x0c, count: 20)), decimals: 18)
+    private let tokenD = Token.erc20(address: Address(raw: Data(repeating: 0x0d, count: 20)), decimals: 18)
+
+    private func pair(_ token0: Token, _ reserve0: BigUInt, _ token1: Token, _ reserve1: BigUInt) -> Pair {
+        Pair(reserve0: TokenAmount(token: token0, rawAmount: reserve0), reserve1: TokenAmount(token: token1, rawAmount: reserve1))
+    }
+
+    // a shallow direct A-B pair and a deep route through C
+    private var pairs: [Pair] {
+        [
+            pair(tokenA, 1000, tokenB, 1000),
+            pair(tokenA, 10000, tokenC, 10000),
+            pair(tokenC, 10000, tokenB, 10000)
+        ]
+    }
+
+    func testTradesExactIn_AllRoutes() throws {
+        let trades = try TradeManager.tradesExactIn(pairs: pairs, tokenAmountIn: TokenAmount(token: tokenA, rawAmount: 100), tokenOut: tokenB)
+
+        XCTAssertEqual(trades.map { $0.route.path }, [[tokenA, tokenB], [tokenA, tokenC, tokenB]])
+        XCTAssertEqual(trades.map { $0.tokenAmountOut.rawAmount }, [90, 96])
+    }
+
+    func testTradesExactIn_BestTrade() throws {
+        let bestTrade = try TradeManager.tradesExactIn(pairs: pairs, tokenAmountIn: TokenAmount(token: tokenA, rawAmount: 100), tokenOut: tokenB).sorted().first
+
+        XCTAssertEqual(bestTrade?.route.path, [tokenA, tokenC, tokenB])
+        XCTAssertEqual(bestTrade?.tokenAmountIn.rawAmount, 100)
+        XCTAssertEqual(bestTrade?.tokenAmountOut.rawAmount, 96)
+    }
+
+    func testTradesExactIn_MaxHops() throws {
+        let trades = try TradeManager.tradesExactIn(pairs: pairs, tokenAmountIn: TokenAmount(token: tokenA, rawAmount: 100), tokenOut: tokenB, maxHops: 1)
+
+        XCTAssertEqual(trades.map { $0.route.path }, [[tokenA, tokenB]])
+    }
+
+    func testTradesExactIn_SkipsEmptyReserves() throws {
+        let pairs = [pair(tokenA, 0, tokenB, 0), pair(tokenA, 10000, tokenC, 10000), pair(tokenC, 10000, tokenB, 10000)]
+        let trades = try TradeManager.tradesExactIn(pairs: pairs, tokenAmountIn: TokenAmount(token: tokenA, rawAmount: 100), tokenOut: tokenB)
+
+        XCTAssertEqual(trades.map { $0.route.path }, [[tokenA, tokenC, tokenB]])
+    }
+
+    func testTradesExactIn_NoRoute() throws {
+        let trades = try TradeManager.tradesExactIn(pairs: pairs, tokenAmountIn: TokenAmount(token: tokenA, rawAmount: 100), tokenOut: tokenD)
+
+        XCTAssertTrue(trades.isEmpty)
+    }
+
+    func testTradesExactOut_BestTrade() throws {
+        let trades = try TradeManager.tradesExactOut(pairs: pairs, tokenIn: tokenA, tokenAmountOut: TokenAmount(token: tokenB, rawAmount: 50))
+        let bestTrade = trades.sorted().first
+
+        XCTAssertEqual(trades.count, 2)
+        XCTAssertEqual(bestTrade?.route.path, [tokenA, tokenC, tokenB])
+        XCTAssertEqual(bestTrade?.tokenAmountIn.rawAmount, 52)
+        XCTAssertEqual(bestTrade?.tokenAmountOut.rawAmount, 50)
+    }
+
+    func testTradesExactOut_InsufficientReserveOut() throws {
+        let trades = try TradeManager.tradesExactOut(pairs: pairs, tokenIn: tokenA, tokenAmountOut: TokenAmount(token: tokenB, rawAmount: 1000))
+
+        XCTAssertEqual(trades.map { $0.route.path }, [[tokenA, tokenC, tokenB]])
+    }
+
+}
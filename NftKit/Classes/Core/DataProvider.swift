@@ -21,11 +21,11 @@ extension DataProvider {
     func getEip1155Balance(contractAddress: Address, owner: Address, tokenId: BigUInt) -> Single<Int> {
         evmKit.call(contractAddress: contractAddress, data: Eip1155BalanceOfMethod(owner: owner, tokenId: tokenId).encodedABI())
                 .flatMap { data -> Single<Int> in
-                    guard let value = BigUInt(data.prefix(32).hex, radix: 16) else {
+                    guard !data.isEmpty else {
                         return Single.error(ContractCallError.invalidBalanceData)
                     }
 
-                    return Single.just(Int(value))
+                    return Single.just(Int(BigUInt(data.prefix(32))))
                 }
     }
 
@@ -6,6 +6,9 @@ class Eip721TransactionSyncer {
     private let provider: ITransactionProvider
     private let storage: Storage
 
+    private let queue = DispatchQueue(label: "io.horizontal-systems.nft-kit.eip721-transaction-syncer", qos: .utility)
+    private var pendingEvents = [Eip721Event]()
+
     weak var delegate: ITransactionSyncerDelegate?
 
     init(provider: ITransactionProvider, storage: Storage) {
@@ -13,11 +16,8 @@ class Eip721TransactionSyncer {
         self.storage = storage
     }
 
+    // the last stored event is the checkpoint of this syncer, so events are saved only after their transactions are stored
     private func handle(transactions: [ProviderEip721Transaction]) {
-        guard !transactions.isEmpty else {
-            return
-        }
-
         let events = transactions.map { tx in
             Eip721Event(
                     hash: tx.hash,
@@ -32,18 +32,9 @@ class Eip721TransactionSyncer {
             )
         }
 
-        try? storage.save(eip721Events: events)
-
-        let nfts = Set<Nft>(events.map { event in
-            Nft(
-                    type: .eip721,
-                    contractAddress: event.contractAddress,
-                    tokenId: event.tokenId,
-                    tokenName: event.tokenName
-            )
-        })
-
-        delegate?.didSync(nfts: Array(nfts), type: .eip721)
+        queue.sync {
+            pendingEvents = events
+        }
     }
 
 }
@@ -54,6 +45,10 @@ extension Eip721TransactionSyncer: ITransactionSyncer {
         let lastBlockNumber = (try? storage.lastEip721Event()?.blockNumber) ?? 0
         let initial = lastBlockNumber == 0
 
+        queue.sync {
+            pendingEvents = []
+        }
+
         return provider.eip721TransactionsSingle(startBlock: lastBlockNumber + 1)
                 .do(onSuccess: { [weak self] transactions in
                     self?.handle(transactions: transactions)
@@ -79,3 +74,31 @@ extension Eip721TransactionSyncer: ITransactionSyncer {
     }
 
 }
+
+extension Eip721TransactionSyncer: ICheckpointedTransactionSyncer {
+
+    func saveCheckpoint() {
+        let events = queue.sync { () -> [Eip721Event] in
+            defer { pendingEvents = [] }
+            return pendingEvents
+        }
+
+        guard !events.isEmpty else {
+            return
+        }
+
+        try? storage.save(eip721Events: events)
+
+        let nfts = Set<Nft>(events.map { event in
+            Nft(
+                    type: .eip721,
+                    contractAddress: event.contractAddress,
+                    tokenId: event.tokenId,
+                    tokenName: event.tokenName
+            )
+        })
+
+        delegate?.didSync(nfts: Array(nfts), type: .eip721)
+    }
+
+}
@@ -11,6 +11,11 @@ class OneInchMethodDecorator {
 
 extension OneInchMethodDecorator: IMethodDecorator {
 
+    // factories are only read after they are registered
+    public var isThreadSafe: Bool {
+        true
+    }
+
     public func contractMethod(input: Data) -> ContractMethod? {
         contractMethodFactories.createMethod(input: input)
     }
@@ -34,13 +34,10 @@ extension Kit {
     public func swapDataSingle(tokenIn: Token, tokenOut: Token) -> Single<SwapData> {
         let tokenPairs = pairSelector.tokenPairs(tokenA: tokenIn, tokenB: tokenOut)
 
-        let singles = tokenPairs.map { tokenA, tokenB in
-            tradeManager.pairSingle(tokenA: tokenA, tokenB: tokenB)
-        }
-
-        return Single.zip(singles) { pairs in
-            SwapData(pairs: pairs, tokenIn: tokenIn, tokenOut: tokenOut)
-        }
+        return tradeManager.pairsSingle(tokenPairs: tokenPairs)
+                .map { pairs in
+                    SwapData(pairs: pairs, tokenIn: tokenIn, tokenOut: tokenOut)
+                }
     }
 
     public func bestTradeExactIn(swapData: SwapData, amountIn: Decimal, options: TradeOptions = TradeOptions()) throws -> TradeData {
@@ -96,7 +93,7 @@ extension Kit {
     public static func instance(evmKit: EthereumKit.Kit) throws -> Kit {
         let address = evmKit.address
 
-        let tradeManager = try TradeManager(evmKit: evmKit, address: address)
+        let tradeManager = try TradeManager(evmKit: evmKit, multicallProvider: MulticallProvider.instance(evmKit: evmKit), address: address)
         let tokenFactory = try TokenFactory(chain: evmKit.chain)
         let pairSelector = PairSelector(tokenFactory: tokenFactory)
 
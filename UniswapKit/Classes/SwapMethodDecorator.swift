@@ -12,6 +12,11 @@ class SwapMethodDecorator {
 
 extension SwapMethodDecorator: IMethodDecorator {
 
+    // factories are only read after they are registered
+    public var isThreadSafe: Bool {
+        true
+    }
+
     public func contractMethod(input: Data) -> ContractMethod? {
         contractMethodFactories.createMethod(input: input)
     }
@@ -9,17 +9,78 @@ class TradeManager {
     private let initCodeHashString: String
 
     private let evmKit: EthereumKit.Kit
+    private let multicallProvider: MulticallProvider
     private let address: Address
 
-    init(evmKit: EthereumKit.Kit, address: Address) throws {
+    private let queue = DispatchQueue(label: "io.horizontal-systems.uniswap-kit.trade-manager", qos: .utility)
+    private var reserves = [Address: (BigUInt, BigUInt)]()
+    private var reservesBlockHeight: Int?
+
+    init(evmKit: EthereumKit.Kit, multicallProvider: MulticallProvider, address: Address) throws {
         routerAddress = try Self.routerAddress(chain: evmKit.chain)
         factoryAddressString = try Self.factoryAddressString(chain: evmKit.chain)
         initCodeHashString = try Self.initCodeHashString(chain: evmKit.chain)
 
         self.evmKit = evmKit
+        self.multicallProvider = multicallProvider
         self.address = address
     }
 
+    // reserves are kept for the block they were read at, so that quotes within one block do not hit the network
+    private func cachedReserves(pairAddresses: [Address], blockHeight: Int?) -> [(BigUInt, BigUInt)]? {
+        queue.sync {
+            guard let blockHeight = blockHeight, blockHeight == reservesBlockHeight else {
+                return nil
+            }
+
+            let cached = pairAddresses.compactMap { reserves[$0] }
+            return cached.count == pairAddresses.count ? cached : nil
+        }
+    }
+
+    private func cache(reserves pairReserves: [(BigUInt, BigUInt)], pairAddresses: [Address], blockHeight: Int?) {
+        guard let blockHeight = blockHeight else {
+            return
+        }
+
+        queue.sync {
+            if blockHeight != reservesBlockHeight {
+                reserves = [:]
+                reservesBlockHeight = blockHeight
+            }
+
+            for (pairAddress, pairReserves) in zip(pairAddresses, pairReserves) {
+                reserves[pairAddress] = pairReserves
+            }
+        }
+    }
+
+    private func reservesSingle(pairAddresses: [Address]) -> Single<[(BigUInt, BigUInt)]> {
+        let blockHeight = evmKit.lastBlockHeight
+
+        if let cached = cachedReserves(pairAddresses: pairAddresses, blockHeight: blockHeight) {
+            return Single.just(cached)
+        }
+
+        let calls = pairAddresses.map { MulticallProvider.Call(contractAddress: $0, data: GetReservesMethod().encodedABI()) }
+        let defaultBlockParameter: DefaultBlockParameter = blockHeight.map { .blockNumber(value: $0) } ?? .latest
+
+        return multicallProvider.callsSingle(calls: calls, defaultBlockParameter: defaultBlockParameter)
+                .map { [weak self] results -> [(BigUInt, BigUInt)] in
+                    // pairs that do not exist have no code, so their calls succeed with empty data
+                    let pairReserves = results.map { data -> (BigUInt, BigUInt) in
+                        guard let data = data, data.count == 3 * 32 else {
+                            return (0, 0)
+                        }
+
+                        return (BigUInt(data[0...31]), BigUInt(data[32...63]))
+                    }
+
+                    self?.cache(reserves: pairReserves, pairAddresses: pairAddresses, blockHeight: blockHeight)
+                    return pairReserves
+                }
+    }
+
     private func buildSwapData(tradeData: TradeData) throws -> SwapData {
         let trade = tradeData.trade
 
@@ -89,31 +150,23 @@ class TradeManager {
 
 extension TradeManager {
 
-    func pairSingle(tokenA: Token, tokenB: Token) -> Single<Pair> {
-        let (token0, token1) = tokenA.sortsBefore(token: tokenB) ? (tokenA, tokenB) : (tokenB, tokenA)
-
-        let pairAddress = Pair.address(token0: token0, token1: token1, factoryAddressString: factoryAddressString, initCodeHashString: initCodeHashString)
-
-//        print("PAIR ADDRESS: \(pairAddress.toHexString())")
-
-        return evmKit.call(contractAddress: pairAddress, data: GetReservesMethod().encodedABI())
-                .map { data in
-//                    print("DATA: \(data.toHexString())")
+    func pairsSingle(tokenPairs: [(Token, Token)]) -> Single<[Pair]> {
+        let sortedTokenPairs = tokenPairs.map { tokenA, tokenB in
+            tokenA.sortsBefore(token: tokenB) ? (tokenA, tokenB) : (tokenB, tokenA)
+        }
 
-                    var rawReserve0: BigUInt = 0
-                    var rawReserve1: BigUInt = 0
+        let pairAddresses = sortedTokenPairs.map { token0, token1 in
+            Pair.address(token0: token0, token1: token1, factoryAddressString: factoryAddressString, initCodeHashString: initCodeHashString)
+        }
 
-                    if data.count == 3 * 32 {
-                        rawReserve0 = BigUInt(data[0...31])
-                        rawReserve1 = BigUInt(data[32...63])
+        return reservesSingle(pairAddresses: pairAddresses)
+                .map { pairReserves in
+                    zip(sortedTokenPairs, pairReserves).map { tokens, rawReserves in
+                        Pair(
+                                reserve0: TokenAmount(token: tokens.0, rawAmount: rawReserves.0),
+                                reserve1: TokenAmount(token: tokens.1, rawAmount: rawReserves.1)
+                        )
                     }
-
-//                    print("Reserve0: \(reserve0), Reserve1: \(reserve1)")
-
-                    let reserve0 = TokenAmount(token: token0, rawAmount: rawReserve0)
-                    let reserve1 = TokenAmount(token: token1, rawAmount: rawReserve1)
-
-                    return Pair(reserve0: reserve0, reserve1: reserve1)
                 }
     }
 